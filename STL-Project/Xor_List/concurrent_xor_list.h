@@ -0,0 +1,161 @@
+#ifndef XOR_CONCURRENT_XOR_LIST_H
+#define XOR_CONCURRENT_XOR_LIST_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include "xor_list.h"
+
+namespace my_std
+{
+    // One writer pushes at the back and pops at either end while any number
+    // of readers walk the list without locks. Popping the front never
+    // rewrites a surviving link: the popped node's address stays behind as
+    // the XOR key of the new front, and readers take the (key, front) pair
+    // from a seqlock, so a reader parked on any node still decodes the same
+    // successor. Link words are atomic and stored with release, and popped
+    // nodes are retired through epochs and freed only once no reader that
+    // could reach them is still pinned. Writer members must be called from
+    // one thread at a time.
+    //
+    // At most max_readers readers can be alive at once; read() throws
+    // std::logic_error when every slot is taken. A reader that stays alive
+    // keeps every node retired after it was created, so pending_reclaim()
+    // grows with the writer's pops until that reader is destroyed.
+    template <typename T, typename allocator = Allocator<T>>
+    class concurrent_xor_list
+    {
+        struct Node
+        {
+            T m_data;
+            std::atomic<std::uintptr_t> m_next_prev;
+            Node(const T &val);
+        };
+        using node_allocator = typename allocator::template rebind<Node>::other;
+
+        struct alignas(64) ReaderSlot
+        {
+            std::atomic<std::uint64_t> m_epoch{0};
+        };
+
+    public:
+        class reader;
+        class const_iterator;
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using allocator_type = allocator;
+
+        static constexpr size_type max_readers = 64;
+        static constexpr size_type reclaim_batch = 64;
+
+    public:
+        concurrent_xor_list() = default;
+        explicit concurrent_xor_list(const allocator &aloc);
+        concurrent_xor_list(const concurrent_xor_list &) = delete;
+        concurrent_xor_list &operator=(const concurrent_xor_list &) = delete;
+        ~concurrent_xor_list();
+
+    public:
+        void push_back(const_reference val);
+        void pop_front();
+        void pop_back();
+        bool try_pop_front(reference out);
+        bool try_pop_back(reference out);
+        void clear();
+        void reclaim();
+        size_type pending_reclaim() const;
+
+        size_type size() const;
+        bool empty() const;
+        reader read() const;
+
+    private:
+        static std::uintptr_t key(Node *node);
+        static Node *decode(std::uintptr_t prev, const Node *node);
+        void publish_front(std::uintptr_t prev, Node *front);
+        void retire(Node *node);
+        bool try_advance();
+        void free_node(Node *node);
+        ReaderSlot *pin() const;
+
+    private:
+        std::atomic<std::uint64_t> m_sequence{0};
+        std::atomic<std::uintptr_t> m_front_prev{0};
+        std::atomic<Node *> m_front{nullptr};
+        Node *m_back = nullptr;
+        std::atomic<size_type> m_size{0};
+
+        std::atomic<std::uint64_t> m_epoch{1};
+        mutable ReaderSlot m_slots[max_readers];
+        std::deque<std::pair<Node *, std::uint64_t>> m_retired;
+        size_type m_next_reclaim = reclaim_batch;
+        node_allocator m_allocator;
+    };
+
+    template <typename T, typename allocator>
+    class concurrent_xor_list<T, allocator>::const_iterator
+    {
+        friend class concurrent_xor_list<T, allocator>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+    public:
+        const_iterator() = default;
+
+        reference operator*() const;
+        pointer operator->() const;
+
+        const_iterator &operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator &rhv) const;
+
+    private:
+        const_iterator(std::uintptr_t prev, const Node *current);
+
+        std::uintptr_t m_prev = 0;
+        const Node *m_current = nullptr;
+    };
+
+    // Pins the reader's epoch for its lifetime; every node reachable from
+    // begin() stays allocated until the reader is destroyed.
+    template <typename T, typename allocator>
+    class concurrent_xor_list<T, allocator>::reader
+    {
+        friend class concurrent_xor_list<T, allocator>;
+
+    public:
+        reader(const reader &) = delete;
+        reader &operator=(const reader &) = delete;
+        reader(reader &&rhv) noexcept;
+        reader &operator=(reader &&) = delete;
+        ~reader();
+
+        const_iterator begin() const;
+        const_iterator end() const;
+
+    private:
+        explicit reader(const concurrent_xor_list *list);
+
+        ReaderSlot *m_slot;
+        std::uintptr_t m_prev = 0;
+        const Node *m_front = nullptr;
+    };
+}
+#include "concurrent_xor_list.hpp"
+#endif
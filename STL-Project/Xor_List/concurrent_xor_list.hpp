@@ -0,0 +1,363 @@
+#ifndef XOR_CONCURRENT_XOR_LIST_HPP
+#define XOR_CONCURRENT_XOR_LIST_HPP
+#include "concurrent_xor_list.h"
+
+namespace my_std
+{
+    template <typename T, typename allocator>
+    concurrent_xor_list<T, allocator>::Node::Node(const T &val) : m_data(val), m_next_prev(0) {}
+
+    template <typename T, typename allocator>
+    concurrent_xor_list<T, allocator>::concurrent_xor_list(const allocator &aloc) : m_allocator(aloc) {}
+
+    template <typename T, typename allocator>
+    concurrent_xor_list<T, allocator>::~concurrent_xor_list()
+    {
+        std::uintptr_t prev = m_front_prev.load(std::memory_order_relaxed);
+        Node *current = m_front.load(std::memory_order_relaxed);
+        while (current)
+        {
+            Node *next = decode(prev, current);
+            prev = key(current);
+            free_node(current);
+            current = next;
+        }
+        for (auto &retired : m_retired)
+        {
+            free_node(retired.first);
+        }
+    }
+
+    template <typename T, typename allocator>
+    std::uintptr_t concurrent_xor_list<T, allocator>::key(Node *node)
+    {
+        return reinterpret_cast<std::uintptr_t>(node);
+    }
+
+    template <typename T, typename allocator>
+    typename concurrent_xor_list<T, allocator>::Node *concurrent_xor_list<T, allocator>::decode(std::uintptr_t prev, const Node *node)
+    {
+        return reinterpret_cast<Node *>(prev ^ node->m_next_prev.load(std::memory_order_acquire));
+    }
+
+    template <typename T, typename allocator>
+    void concurrent_xor_list<T, allocator>::publish_front(std::uintptr_t prev, Node *front)
+    {
+        std::uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_front_prev.store(prev, std::memory_order_relaxed);
+        m_front.store(front, std::memory_order_relaxed);
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    template <typename T, typename allocator>
+    void concurrent_xor_list<T, allocator>::push_back(const_reference val)
+    {
+        Node *node = m_allocator.allocate();
+        m_allocator.construct(node, val);
+        if (!m_back)
+        {
+            m_back = node;
+            publish_front(0, node);
+        }
+        else
+        {
+            node->m_next_prev.store(key(m_back), std::memory_order_relaxed);
+            m_back->m_next_prev.store(m_back->m_next_prev.load(std::memory_order_relaxed) ^ key(node), std::memory_order_release);
+            m_back = node;
+        }
+        m_size.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <typename T, typename allocator>
+    void concurrent_xor_list<T, allocator>::pop_front()
+    {
+        Node *front = m_front.load(std::memory_order_relaxed);
+        if (!front)
+        {
+            throw std::logic_error("List is empty");
+        }
+
+        if (front == m_back)
+        {
+            m_back = nullptr;
+            publish_front(0, nullptr);
+        }
+        else
+        {
+            publish_front(key(front), decode(m_front_prev.load(std::memory_order_relaxed), front));
+        }
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        retire(front);
+    }
+
+    template <typename T, typename allocator>
+    void concurrent_xor_list<T, allocator>::pop_back()
+    {
+        Node *back = m_back;
+        if (!back)
+        {
+            throw std::logic_error("List is empty");
+        }
+
+        if (back == m_front.load(std::memory_order_relaxed))
+        {
+            m_back = nullptr;
+            publish_front(0, nullptr);
+        }
+        else
+        {
+            Node *prev = decode(0, back);
+            prev->m_next_prev.store(prev->m_next_prev.load(std::memory_order_relaxed) ^ key(back), std::memory_order_release);
+            m_back = prev;
+        }
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        retire(back);
+    }
+
+    template <typename T, typename allocator>
+    bool concurrent_xor_list<T, allocator>::try_pop_front(reference out)
+    {
+        Node *front = m_front.load(std::memory_order_relaxed);
+        if (!front)
+        {
+            return false;
+        }
+        out = front->m_data;
+        pop_front();
+        return true;
+    }
+
+    template <typename T, typename allocator>
+    bool concurrent_xor_list<T, allocator>::try_pop_back(reference out)
+    {
+        if (!m_back)
+        {
+            return false;
+        }
+        out = m_back->m_data;
+        pop_back();
+        return true;
+    }
+
+    template <typename T, typename allocator>
+    void concurrent_xor_list<T, allocator>::clear()
+    {
+        std::uintptr_t prev = m_front_prev.load(std::memory_order_relaxed);
+        Node *current = m_front.load(std::memory_order_relaxed);
+        m_back = nullptr;
+        publish_front(0, nullptr);
+        m_size.store(0, std::memory_order_relaxed);
+
+        while (current)
+        {
+            Node *next = decode(prev, current);
+            prev = key(current);
+            retire(current);
+            current = next;
+        }
+    }
+
+    template <typename T, typename allocator>
+    void concurrent_xor_list<T, allocator>::retire(Node *node)
+    {
+        m_retired.emplace_back(node, m_epoch.load(std::memory_order_relaxed));
+        if (m_retired.size() < m_next_reclaim)
+        {
+            return;
+        }
+
+        // While a pinned reader holds the epoch back nothing can be freed;
+        // keep the threshold so the next retire tries again instead of
+        // letting another batch pile up first.
+        size_type pending = m_retired.size();
+        reclaim();
+        if (m_retired.size() < pending)
+        {
+            m_next_reclaim = m_retired.size() + reclaim_batch;
+        }
+    }
+
+    template <typename T, typename allocator>
+    bool concurrent_xor_list<T, allocator>::try_advance()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t epoch = m_epoch.load(std::memory_order_relaxed);
+        for (const ReaderSlot &slot : m_slots)
+        {
+            std::uint64_t pinned = slot.m_epoch.load(std::memory_order_seq_cst);
+            if (pinned != 0 && pinned != epoch)
+            {
+                return false;
+            }
+        }
+        m_epoch.store(epoch + 1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    template <typename T, typename allocator>
+    void concurrent_xor_list<T, allocator>::reclaim()
+    {
+        if (m_retired.empty())
+        {
+            return;
+        }
+        try_advance() && try_advance();
+
+        std::uint64_t epoch = m_epoch.load(std::memory_order_relaxed);
+        while (!m_retired.empty() && m_retired.front().second + 2 <= epoch)
+        {
+            free_node(m_retired.front().first);
+            m_retired.pop_front();
+        }
+    }
+
+    template <typename T, typename allocator>
+    typename concurrent_xor_list<T, allocator>::size_type concurrent_xor_list<T, allocator>::pending_reclaim() const
+    {
+        return m_retired.size();
+    }
+
+    template <typename T, typename allocator>
+    void concurrent_xor_list<T, allocator>::free_node(Node *node)
+    {
+        m_allocator.destroy(node);
+        m_allocator.deallocate(node);
+    }
+
+    template <typename T, typename allocator>
+    typename concurrent_xor_list<T, allocator>::size_type concurrent_xor_list<T, allocator>::size() const
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    template <typename T, typename allocator>
+    bool concurrent_xor_list<T, allocator>::empty() const
+    {
+        return size() == 0;
+    }
+
+    template <typename T, typename allocator>
+    typename concurrent_xor_list<T, allocator>::reader concurrent_xor_list<T, allocator>::read() const
+    {
+        return reader(this);
+    }
+
+    template <typename T, typename allocator>
+    typename concurrent_xor_list<T, allocator>::ReaderSlot *concurrent_xor_list<T, allocator>::pin() const
+    {
+        size_type start = std::hash<std::thread::id>()(std::this_thread::get_id());
+        for (size_type i = 0; i < max_readers; ++i)
+        {
+            ReaderSlot &slot = m_slots[(start + i) % max_readers];
+            std::uint64_t expected = 0;
+            if (slot.m_epoch.load(std::memory_order_relaxed) == 0 &&
+                slot.m_epoch.compare_exchange_strong(expected, m_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst))
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                return &slot;
+            }
+        }
+        throw std::logic_error("Too many readers");
+    }
+
+    // ===================================== reader ============================================
+
+    template <typename T, typename allocator>
+    concurrent_xor_list<T, allocator>::reader::reader(const concurrent_xor_list *list) : m_slot(list->pin())
+    {
+        while (true)
+        {
+            std::uint64_t sequence = list->m_sequence.load(std::memory_order_acquire);
+            if (sequence & 1)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            m_prev = list->m_front_prev.load(std::memory_order_relaxed);
+            m_front = list->m_front.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (list->m_sequence.load(std::memory_order_relaxed) == sequence)
+            {
+                return;
+            }
+        }
+    }
+
+    template <typename T, typename allocator>
+    concurrent_xor_list<T, allocator>::reader::reader(reader &&rhv) noexcept
+        : m_slot(std::exchange(rhv.m_slot, nullptr)), m_prev(rhv.m_prev), m_front(rhv.m_front)
+    {
+    }
+
+    template <typename T, typename allocator>
+    concurrent_xor_list<T, allocator>::reader::~reader()
+    {
+        if (m_slot)
+        {
+            m_slot->m_epoch.store(0, std::memory_order_release);
+        }
+    }
+
+    template <typename T, typename allocator>
+    typename concurrent_xor_list<T, allocator>::const_iterator concurrent_xor_list<T, allocator>::reader::begin() const
+    {
+        return const_iterator(m_prev, m_front);
+    }
+
+    template <typename T, typename allocator>
+    typename concurrent_xor_list<T, allocator>::const_iterator concurrent_xor_list<T, allocator>::reader::end() const
+    {
+        return const_iterator();
+    }
+
+    // =====================================const iterator ============================================
+
+    template <typename T, typename allocator>
+    concurrent_xor_list<T, allocator>::const_iterator::const_iterator(std::uintptr_t prev, const Node *current) : m_prev(prev), m_current(current) {}
+
+    template <typename T, typename allocator>
+    typename concurrent_xor_list<T, allocator>::const_iterator::reference concurrent_xor_list<T, allocator>::const_iterator::operator*() const
+    {
+        if (!m_current)
+        {
+            throw std::logic_error("Trying to dereference an invalid iterator");
+        }
+        return m_current->m_data;
+    }
+
+    template <typename T, typename allocator>
+    typename concurrent_xor_list<T, allocator>::const_iterator::pointer concurrent_xor_list<T, allocator>::const_iterator::operator->() const
+    {
+        return std::addressof(**this);
+    }
+
+    template <typename T, typename allocator>
+    typename concurrent_xor_list<T, allocator>::const_iterator &concurrent_xor_list<T, allocator>::const_iterator::operator++()
+    {
+        if (!m_current)
+        {
+            throw std::logic_error("Incrementing an invalid iterator");
+        }
+        const Node *next = decode(m_prev, m_current);
+        m_prev = reinterpret_cast<std::uintptr_t>(m_current);
+        m_current = next;
+        return *this;
+    }
+
+    template <typename T, typename allocator>
+    typename concurrent_xor_list<T, allocator>::const_iterator concurrent_xor_list<T, allocator>::const_iterator::operator++(int)
+    {
+        const_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    template <typename T, typename allocator>
+    bool concurrent_xor_list<T, allocator>::const_iterator::operator==(const const_iterator &rhv) const
+    {
+        return m_current == rhv.m_current;
+    }
+}
+#endif
@@ -0,0 +1,28 @@
+#ifndef XOR_CONSTEXPR_XOR_LIST_H
+#define XOR_CONSTEXPR_XOR_LIST_H
+
+#include <array>
+#include <cstddef>
+#include "index_xor_list.h"
+
+namespace my_std
+{
+    // xor_list links nodes by XOR-ing their addresses, which constant evaluation
+    // cannot do. This is index_xor_list over a std::allocator-backed array that
+    // grows as needed, so every member is constexpr and lists built at compile
+    // time can be copied out with to_array().
+    template <typename T>
+    class constexpr_xor_list : public index_xor_list<T, heap_xor_slots<T>>
+    {
+        using base = index_xor_list<T, heap_xor_slots<T>>;
+
+    public:
+        using base::base;
+
+    public:
+        template <std::size_t N>
+        constexpr std::array<T, N> to_array() const;
+    };
+}
+#include "constexpr_xor_list.hpp"
+#endif
@@ -0,0 +1,24 @@
+#ifndef XOR_CONSTEXPR_XOR_LIST_HPP
+#define XOR_CONSTEXPR_XOR_LIST_HPP
+#include "constexpr_xor_list.h"
+
+namespace my_std
+{
+    template <typename T>
+    template <std::size_t N>
+    constexpr std::array<T, N> constexpr_xor_list<T>::to_array() const
+    {
+        if (this->size() != N)
+        {
+            throw std::logic_error("Array size does not match list size");
+        }
+        std::array<T, N> result{};
+        std::size_t i = 0;
+        for (const auto &elem : *this)
+        {
+            result[i++] = elem;
+        }
+        return result;
+    }
+}
+#endif
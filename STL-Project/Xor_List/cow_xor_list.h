@@ -0,0 +1,87 @@
+#ifndef XOR_COW_XOR_LIST_H
+#define XOR_COW_XOR_LIST_H
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include "xor_list.h"
+
+namespace my_std
+{
+    // Copies share one reference-counted xor_list, so copying is a single
+    // atomic increment. Reads go straight to the shared list; the first
+    // mutation through a shared copy clones the chain. Ownership is checked
+    // with an acquire load of the count, which pairs with the release
+    // decrement of every copy that let go, so their reads are finished
+    // before the list is mutated in place. modify() exposes the list only
+    // for the duration of the call. A null list stands for an empty one,
+    // which keeps default construction, moves and clear() allocation-free.
+    template <typename T, typename allocator = Allocator<T>>
+    class cow_xor_list
+    {
+    public:
+        using list_type = xor_list<T, allocator>;
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using const_iterator = typename list_type::const_iterator;
+        using const_reverse_iterator = typename list_type::const_reverse_iterator;
+
+    public:
+        cow_xor_list() = default;
+        cow_xor_list(std::initializer_list<value_type> init);
+        explicit cow_xor_list(list_type list);
+        cow_xor_list(const cow_xor_list &rhv);
+        cow_xor_list(cow_xor_list &&rhv) noexcept;
+        cow_xor_list &operator=(const cow_xor_list &rhv);
+        cow_xor_list &operator=(cow_xor_list &&rhv) noexcept;
+        ~cow_xor_list();
+
+    public:
+        const list_type &read() const;
+        template <typename Fn>
+        decltype(auto) modify(Fn fn);
+
+        size_type size() const;
+        bool empty() const;
+        const_reference front() const;
+        const_reference back() const;
+
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+        const_reverse_iterator rbegin() const;
+        const_reverse_iterator rend() const;
+
+        void push_back(const_reference val);
+        void push_front(const_reference val);
+        void pop_back();
+        void pop_front();
+        void clear();
+        void reverse();
+
+        long use_count() const;
+        bool operator==(const cow_xor_list &rhv) const;
+
+    private:
+        struct Shared
+        {
+            template <typename... Args>
+            explicit Shared(Args &&...args);
+
+            list_type m_list;
+            std::atomic<long> m_refs{1};
+        };
+
+        static const list_type &empty_list();
+        bool unique() const;
+        void release();
+
+    private:
+        Shared *m_shared = nullptr;
+    };
+}
+#include "cow_xor_list.hpp"
+#endif
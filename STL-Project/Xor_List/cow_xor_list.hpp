@@ -0,0 +1,239 @@
+#ifndef XOR_COW_XOR_LIST_HPP
+#define XOR_COW_XOR_LIST_HPP
+#include "cow_xor_list.h"
+
+namespace my_std
+{
+    template <typename T, typename allocator>
+    template <typename... Args>
+    cow_xor_list<T, allocator>::Shared::Shared(Args &&...args) : m_list(std::forward<Args>(args)...) {}
+
+    template <typename T, typename allocator>
+    cow_xor_list<T, allocator>::cow_xor_list(std::initializer_list<value_type> init) : m_shared(new Shared(init)) {}
+
+    template <typename T, typename allocator>
+    cow_xor_list<T, allocator>::cow_xor_list(list_type list) : m_shared(new Shared(std::move(list))) {}
+
+    template <typename T, typename allocator>
+    cow_xor_list<T, allocator>::cow_xor_list(const cow_xor_list &rhv) : m_shared(rhv.m_shared)
+    {
+        if (m_shared)
+        {
+            m_shared->m_refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename T, typename allocator>
+    cow_xor_list<T, allocator>::cow_xor_list(cow_xor_list &&rhv) noexcept : m_shared(std::exchange(rhv.m_shared, nullptr)) {}
+
+    template <typename T, typename allocator>
+    cow_xor_list<T, allocator> &cow_xor_list<T, allocator>::operator=(const cow_xor_list &rhv)
+    {
+        cow_xor_list copy(rhv);
+        std::swap(m_shared, copy.m_shared);
+        return *this;
+    }
+
+    template <typename T, typename allocator>
+    cow_xor_list<T, allocator> &cow_xor_list<T, allocator>::operator=(cow_xor_list &&rhv) noexcept
+    {
+        if (this != &rhv)
+        {
+            release();
+            m_shared = std::exchange(rhv.m_shared, nullptr);
+        }
+        return *this;
+    }
+
+    template <typename T, typename allocator>
+    cow_xor_list<T, allocator>::~cow_xor_list()
+    {
+        release();
+    }
+
+    template <typename T, typename allocator>
+    bool cow_xor_list<T, allocator>::unique() const
+    {
+        return m_shared->m_refs.load(std::memory_order_acquire) == 1;
+    }
+
+    template <typename T, typename allocator>
+    void cow_xor_list<T, allocator>::release()
+    {
+        if (m_shared && m_shared->m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete m_shared;
+        }
+        m_shared = nullptr;
+    }
+
+    template <typename T, typename allocator>
+    const typename cow_xor_list<T, allocator>::list_type &cow_xor_list<T, allocator>::read() const
+    {
+        return m_shared ? m_shared->m_list : empty_list();
+    }
+
+    // Hands fn the list once this object owns it alone. The reference must
+    // not outlive the call: a later copy would share whatever fn left behind.
+    template <typename T, typename allocator>
+    template <typename Fn>
+    decltype(auto) cow_xor_list<T, allocator>::modify(Fn fn)
+    {
+        if (!m_shared)
+        {
+            m_shared = new Shared();
+        }
+        else if (!unique())
+        {
+            Shared *copy = new Shared(m_shared->m_list);
+            release();
+            m_shared = copy;
+        }
+        return fn(m_shared->m_list);
+    }
+
+    template <typename T, typename allocator>
+    typename cow_xor_list<T, allocator>::size_type cow_xor_list<T, allocator>::size() const
+    {
+        return read().size();
+    }
+
+    template <typename T, typename allocator>
+    bool cow_xor_list<T, allocator>::empty() const
+    {
+        return read().empty();
+    }
+
+    template <typename T, typename allocator>
+    typename cow_xor_list<T, allocator>::const_reference cow_xor_list<T, allocator>::front() const
+    {
+        return read().front();
+    }
+
+    template <typename T, typename allocator>
+    typename cow_xor_list<T, allocator>::const_reference cow_xor_list<T, allocator>::back() const
+    {
+        return read().back();
+    }
+
+    template <typename T, typename allocator>
+    typename cow_xor_list<T, allocator>::const_iterator cow_xor_list<T, allocator>::begin() const
+    {
+        return read().begin();
+    }
+
+    template <typename T, typename allocator>
+    typename cow_xor_list<T, allocator>::const_iterator cow_xor_list<T, allocator>::end() const
+    {
+        return read().end();
+    }
+
+    template <typename T, typename allocator>
+    typename cow_xor_list<T, allocator>::const_iterator cow_xor_list<T, allocator>::cbegin() const
+    {
+        return read().cbegin();
+    }
+
+    template <typename T, typename allocator>
+    typename cow_xor_list<T, allocator>::const_iterator cow_xor_list<T, allocator>::cend() const
+    {
+        return read().cend();
+    }
+
+    template <typename T, typename allocator>
+    typename cow_xor_list<T, allocator>::const_reverse_iterator cow_xor_list<T, allocator>::rbegin() const
+    {
+        return read().rbegin();
+    }
+
+    template <typename T, typename allocator>
+    typename cow_xor_list<T, allocator>::const_reverse_iterator cow_xor_list<T, allocator>::rend() const
+    {
+        return read().rend();
+    }
+
+    template <typename T, typename allocator>
+    void cow_xor_list<T, allocator>::push_back(const_reference val)
+    {
+        modify([&val](list_type &list)
+               { list.push_back(val); });
+    }
+
+    template <typename T, typename allocator>
+    void cow_xor_list<T, allocator>::push_front(const_reference val)
+    {
+        modify([&val](list_type &list)
+               { list.push_front(val); });
+    }
+
+    template <typename T, typename allocator>
+    void cow_xor_list<T, allocator>::pop_back()
+    {
+        if (empty())
+        {
+            throw std::logic_error("List is empty");
+        }
+        modify([](list_type &list)
+               { list.pop_back(); });
+    }
+
+    template <typename T, typename allocator>
+    void cow_xor_list<T, allocator>::pop_front()
+    {
+        if (empty())
+        {
+            throw std::logic_error("List is empty");
+        }
+        modify([](list_type &list)
+               { list.pop_front(); });
+    }
+
+    template <typename T, typename allocator>
+    void cow_xor_list<T, allocator>::clear()
+    {
+        if (m_shared && unique())
+        {
+            m_shared->m_list.clear();
+            return;
+        }
+        release();
+    }
+
+    template <typename T, typename allocator>
+    void cow_xor_list<T, allocator>::reverse()
+    {
+        if (size() > 1)
+        {
+            modify([](list_type &list)
+               { list.reverse(); });
+        }
+    }
+
+    template <typename T, typename allocator>
+    long cow_xor_list<T, allocator>::use_count() const
+    {
+        return m_shared ? m_shared->m_refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    template <typename T, typename allocator>
+    bool cow_xor_list<T, allocator>::operator==(const cow_xor_list &rhv) const
+    {
+        if (m_shared == rhv.m_shared)
+        {
+            return true;
+        }
+        if (size() != rhv.size())
+        {
+            return false;
+        }
+        return std::equal(begin(), end(), rhv.begin());
+    }
+
+    template <typename T, typename allocator>
+    const typename cow_xor_list<T, allocator>::list_type &cow_xor_list<T, allocator>::empty_list()
+    {
+        static const list_type empty;
+        return empty;
+    }
+}
+#endif
@@ -0,0 +1,114 @@
+#ifndef XOR_HUGE_PAGE_ARENA_H
+#define XOR_HUGE_PAGE_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace my_std
+{
+    // Hands out fixed-size blocks from large 2 MiB aligned regions so that a
+    // list spread over many GB is covered by huge TLB entries. On Linux each
+    // region is mmap'd, optionally with MAP_HUGETLB (falling back to normal
+    // pages when no huge pages are reserved), and advised MADV_HUGEPAGE.
+    // With prefault set, a region is touched by the thread that grows the
+    // arena, so first-touch places it on that thread's NUMA node.
+    class huge_page_arena
+    {
+    public:
+        using size_type = std::size_t;
+
+        static constexpr size_type huge_page_size = size_type(2) << 20;
+
+        struct options
+        {
+            size_type region_size = size_type(64) << 20;
+            bool use_hugetlb = false;
+            bool prefault = false;
+        };
+
+    public:
+        huge_page_arena();
+        explicit huge_page_arena(options opts);
+        huge_page_arena(const huge_page_arena &) = delete;
+        huge_page_arena &operator=(const huge_page_arena &) = delete;
+        ~huge_page_arena();
+
+        static huge_page_arena &global();
+
+    public:
+        void *allocate(size_type bytes);
+        void deallocate(void *ptr, size_type bytes);
+
+        size_type reserved() const;
+        size_type hugetlb_regions() const;
+
+    private:
+        struct Region
+        {
+            void *m_base;
+            size_type m_bytes;
+            bool m_hugetlb;
+        };
+
+        struct FreeBlock
+        {
+            FreeBlock *m_next;
+        };
+
+        static constexpr size_type granularity = alignof(std::max_align_t);
+
+        static size_type size_class(size_type bytes);
+        void grow(size_type bytes);
+        Region map_region(size_type bytes);
+        void unmap_region(const Region &region);
+
+    private:
+        options m_options;
+        std::vector<Region> m_regions;
+        std::vector<FreeBlock *> m_free;
+        char *m_cursor = nullptr;
+        char *m_limit = nullptr;
+        mutable std::mutex m_mutex;
+    };
+
+    template <typename T>
+    class huge_page_allocator
+    {
+        template <typename U>
+        friend class huge_page_allocator;
+
+    public:
+        template <typename U>
+        struct rebind
+        {
+            using other = huge_page_allocator<U>;
+        };
+
+    public:
+        huge_page_allocator();
+        explicit huge_page_allocator(huge_page_arena &arena);
+        template <typename U>
+        huge_page_allocator(const huge_page_allocator<U> &rhv);
+
+        T *allocate();
+        template <typename... Args>
+        void construct(T *ptr, Args &&...args);
+        void destroy(T *ptr);
+        void deallocate(T *ptr);
+
+        huge_page_arena &arena() const;
+
+        template <typename U>
+        bool operator==(const huge_page_allocator<U> &rhv) const;
+
+    private:
+        huge_page_arena *m_arena;
+    };
+}
+#include "huge_page_arena.hpp"
+#endif
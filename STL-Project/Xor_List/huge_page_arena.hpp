@@ -0,0 +1,243 @@
+#ifndef XOR_HUGE_PAGE_ARENA_HPP
+#define XOR_HUGE_PAGE_ARENA_HPP
+#include "huge_page_arena.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace my_std
+{
+    inline huge_page_arena::huge_page_arena() : huge_page_arena(options()) {}
+
+    inline huge_page_arena::huge_page_arena(options opts) : m_options(opts)
+    {
+        m_options.region_size = (m_options.region_size + huge_page_size - 1) / huge_page_size * huge_page_size;
+        if (m_options.region_size == 0)
+        {
+            m_options.region_size = huge_page_size;
+        }
+    }
+
+    inline huge_page_arena::~huge_page_arena()
+    {
+        for (const Region &region : m_regions)
+        {
+            unmap_region(region);
+        }
+    }
+
+    inline huge_page_arena &huge_page_arena::global()
+    {
+        static huge_page_arena arena;
+        return arena;
+    }
+
+    inline void *huge_page_arena::allocate(size_type bytes)
+    {
+        size_type cls = size_class(bytes);
+        size_type rounded = (cls + 1) * granularity;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (cls < m_free.size() && m_free[cls])
+        {
+            FreeBlock *block = m_free[cls];
+            m_free[cls] = block->m_next;
+            return block;
+        }
+        if (static_cast<size_type>(m_limit - m_cursor) < rounded)
+        {
+            grow(rounded);
+        }
+        void *ptr = m_cursor;
+        m_cursor += rounded;
+        return ptr;
+    }
+
+    inline void huge_page_arena::deallocate(void *ptr, size_type bytes)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+        size_type cls = size_class(bytes);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (cls >= m_free.size())
+        {
+            m_free.resize(cls + 1, nullptr);
+        }
+        FreeBlock *block = ::new (ptr) FreeBlock{m_free[cls]};
+        m_free[cls] = block;
+    }
+
+    inline huge_page_arena::size_type huge_page_arena::reserved() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_type total = 0;
+        for (const Region &region : m_regions)
+        {
+            total += region.m_bytes;
+        }
+        return total;
+    }
+
+    inline huge_page_arena::size_type huge_page_arena::hugetlb_regions() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_type count = 0;
+        for (const Region &region : m_regions)
+        {
+            count += region.m_hugetlb;
+        }
+        return count;
+    }
+
+    inline huge_page_arena::size_type huge_page_arena::size_class(size_type bytes)
+    {
+        if (bytes < sizeof(FreeBlock))
+        {
+            bytes = sizeof(FreeBlock);
+        }
+        return (bytes + granularity - 1) / granularity - 1;
+    }
+
+    inline void huge_page_arena::grow(size_type bytes)
+    {
+        size_type size = m_options.region_size;
+        while (size < bytes)
+        {
+            size += huge_page_size;
+        }
+
+        Region region = map_region(size);
+        m_regions.push_back(region);
+        m_cursor = static_cast<char *>(region.m_base);
+        m_limit = m_cursor + region.m_bytes;
+
+        if (m_options.prefault)
+        {
+            for (char *page = m_cursor; page < m_limit; page += 4096)
+            {
+                *static_cast<volatile char *>(page) = 0;
+            }
+        }
+    }
+
+#if defined(__linux__)
+    inline huge_page_arena::Region huge_page_arena::map_region(size_type bytes)
+    {
+        const int prot = PROT_READ | PROT_WRITE;
+        const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#if defined(MAP_HUGETLB)
+        if (m_options.use_hugetlb)
+        {
+            void *base = ::mmap(nullptr, bytes, prot, flags | MAP_HUGETLB, -1, 0);
+            if (base != MAP_FAILED)
+            {
+                return Region{base, bytes, true};
+            }
+        }
+#endif
+
+        size_type padded = bytes + huge_page_size;
+        void *raw = ::mmap(nullptr, padded, prot, flags, -1, 0);
+        if (raw == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+
+        char *start = static_cast<char *>(raw);
+        char *aligned = reinterpret_cast<char *>((reinterpret_cast<std::uintptr_t>(start) + huge_page_size - 1) & ~(huge_page_size - 1));
+        if (aligned != start)
+        {
+            ::munmap(start, aligned - start);
+        }
+        char *end = aligned + bytes;
+        char *raw_end = start + padded;
+        if (raw_end != end)
+        {
+            ::munmap(end, raw_end - end);
+        }
+
+#if defined(MADV_HUGEPAGE)
+        ::madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif
+        return Region{aligned, bytes, false};
+    }
+
+    inline void huge_page_arena::unmap_region(const Region &region)
+    {
+        ::munmap(region.m_base, region.m_bytes);
+    }
+#else
+    inline huge_page_arena::Region huge_page_arena::map_region(size_type bytes)
+    {
+        void *base = std::aligned_alloc(huge_page_size, bytes);
+        if (!base)
+        {
+            throw std::bad_alloc();
+        }
+        return Region{base, bytes, false};
+    }
+
+    inline void huge_page_arena::unmap_region(const Region &region)
+    {
+        std::free(region.m_base);
+    }
+#endif
+
+    // =====================================huge page allocator ============================================
+
+    template <typename T>
+    huge_page_allocator<T>::huge_page_allocator() : m_arena(&huge_page_arena::global()) {}
+
+    template <typename T>
+    huge_page_allocator<T>::huge_page_allocator(huge_page_arena &arena) : m_arena(&arena) {}
+
+    template <typename T>
+    template <typename U>
+    huge_page_allocator<T>::huge_page_allocator(const huge_page_allocator<U> &rhv) : m_arena(rhv.m_arena) {}
+
+    template <typename T>
+    T *huge_page_allocator<T>::allocate()
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "huge_page_allocator does not support over-aligned types");
+        return static_cast<T *>(m_arena->allocate(sizeof(T)));
+    }
+
+    template <typename T>
+    template <typename... Args>
+    void huge_page_allocator<T>::construct(T *ptr, Args &&...args)
+    {
+        ::new (ptr) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    void huge_page_allocator<T>::destroy(T *ptr)
+    {
+        ptr->~T();
+    }
+
+    template <typename T>
+    void huge_page_allocator<T>::deallocate(T *ptr)
+    {
+        m_arena->deallocate(ptr, sizeof(T));
+    }
+
+    template <typename T>
+    huge_page_arena &huge_page_allocator<T>::arena() const
+    {
+        return *m_arena;
+    }
+
+    template <typename T>
+    template <typename U>
+    bool huge_page_allocator<T>::operator==(const huge_page_allocator<U> &rhv) const
+    {
+        return m_arena == rhv.m_arena;
+    }
+}
+#endif
@@ -0,0 +1,209 @@
+#ifndef XOR_INDEX_XOR_LIST_H
+#define XOR_INDEX_XOR_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <initializer_list>
+
+namespace my_std
+{
+    // A slot of an index-linked list. While the slot is free its union holds
+    // m_empty, so a list with unused slots is still fully initialized and can
+    // be the value of a constexpr variable. The slot is trivially
+    // destructible whenever T is.
+    template <typename T, typename Index>
+    struct index_xor_slot
+    {
+        union
+        {
+            char m_empty;
+            T m_data;
+        };
+        Index m_next_prev;
+        bool m_live;
+        constexpr index_xor_slot();
+        constexpr ~index_xor_slot()
+            requires std::is_trivially_destructible_v<T>
+        = default;
+        constexpr ~index_xor_slot();
+    };
+
+    // N slots stored inside the object. Links take 16 bits when N allows it.
+    template <typename T, std::size_t N>
+    class inline_xor_slots
+    {
+    public:
+        using index_type = std::conditional_t<(N < UINT16_MAX), std::uint16_t, std::uint32_t>;
+        using slot_type = index_xor_slot<T, index_type>;
+        static constexpr bool steals = false;
+
+        constexpr bool reserve(std::size_t count);
+        constexpr slot_type &operator[](std::size_t pos);
+        constexpr const slot_type &operator[](std::size_t pos) const;
+
+    private:
+        slot_type m_slots[N]{};
+    };
+
+    // Slots in a std::allocator array that doubles when full. Constant
+    // evaluation accepts it as long as the array is freed before it ends.
+    template <typename T>
+    class heap_xor_slots
+    {
+    public:
+        using index_type = std::size_t;
+        using slot_type = index_xor_slot<T, index_type>;
+        static constexpr bool steals = true;
+
+        constexpr heap_xor_slots() = default;
+        heap_xor_slots(const heap_xor_slots &) = delete;
+        heap_xor_slots &operator=(const heap_xor_slots &) = delete;
+        constexpr ~heap_xor_slots();
+
+        constexpr bool reserve(std::size_t count);
+        constexpr void swap(heap_xor_slots &rhv) noexcept;
+        constexpr slot_type &operator[](std::size_t pos);
+        constexpr const slot_type &operator[](std::size_t pos) const;
+
+    private:
+        slot_type *m_slots = nullptr;
+        std::size_t m_capacity = 0;
+    };
+
+    // xor_list links nodes by XOR-ing their addresses, which constant
+    // evaluation cannot do. This list keeps the same scheme over slot indices
+    // (1-based, 0 means null) with a free list threaded through released
+    // slots, so every member is constexpr. Storage decides where the slots
+    // live: when it cannot grow, try_* members report a full list by
+    // returning false and the rest throw. Moving steals the storage when it
+    // can be handed over and moves element-wise otherwise.
+    template <typename T, typename Storage>
+    class index_xor_list
+    {
+        template <bool Const>
+        class basic_iterator;
+
+    public:
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using index_type = typename Storage::index_type;
+
+    private:
+        using Slot = typename Storage::slot_type;
+
+    public:
+        constexpr index_xor_list() = default;
+        constexpr index_xor_list(std::initializer_list<value_type> init);
+        constexpr index_xor_list(const index_xor_list &rhv);
+        constexpr index_xor_list(index_xor_list &&rhv) noexcept(Storage::steals || std::is_nothrow_move_constructible_v<T>);
+        constexpr ~index_xor_list();
+
+        constexpr index_xor_list &operator=(const index_xor_list &rhv);
+        constexpr index_xor_list &operator=(index_xor_list &&rhv) noexcept(Storage::steals);
+
+    public:
+        constexpr void push_back(const_reference val);
+        constexpr void push_back(value_type &&val);
+        constexpr void push_front(const_reference val);
+        constexpr void push_front(value_type &&val);
+        template <typename... Args>
+        constexpr reference emplace_back(Args &&...args);
+        template <typename... Args>
+        constexpr reference emplace_front(Args &&...args);
+        constexpr bool try_push_back(const_reference val);
+        constexpr bool try_push_front(const_reference val);
+        constexpr void pop_back();
+        constexpr void pop_front();
+        constexpr iterator insert(const_iterator pos, const_reference val);
+        constexpr iterator insert(const_iterator pos, value_type &&val);
+        template <typename... Args>
+        constexpr iterator emplace(const_iterator pos, Args &&...args);
+        constexpr iterator erase(const_iterator pos);
+        constexpr void clear();
+        constexpr void reverse();
+
+        constexpr reference front();
+        constexpr const_reference front() const;
+        constexpr reference back();
+        constexpr const_reference back() const;
+        constexpr size_type size() const;
+        constexpr bool empty() const;
+        constexpr bool contains(const_reference val) const;
+
+        constexpr iterator begin();
+        constexpr const_iterator begin() const;
+        constexpr iterator end();
+        constexpr const_iterator end() const;
+
+        constexpr bool operator==(const index_xor_list &rhv) const;
+
+    private:
+        template <typename... Args>
+        constexpr index_type acquire_slot(Args &&...args);
+        constexpr void release_slot(index_type index);
+        constexpr void link_between(index_type prev, index_type next, index_type index);
+        constexpr Slot &slot(index_type index);
+        constexpr const Slot &slot(index_type index) const;
+
+    private:
+        Storage m_slots;
+        index_type m_used = 0;
+        index_type m_free = 0;
+        index_type m_head = 0;
+        index_type m_tail = 0;
+        size_type m_size = 0;
+    };
+
+    template <typename T, typename Storage>
+    template <bool Const>
+    class index_xor_list<T, Storage>::basic_iterator
+    {
+        friend class index_xor_list<T, Storage>;
+        friend class basic_iterator<true>;
+        using list_pointer = std::conditional_t<Const, const index_xor_list *, index_xor_list *>;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = std::conditional_t<Const, const T &, T &>;
+
+    public:
+        constexpr basic_iterator() = default;
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        constexpr basic_iterator(const basic_iterator<OtherConst> &rhv);
+
+        constexpr reference operator*() const;
+        constexpr pointer operator->() const;
+
+        constexpr basic_iterator &operator++();
+        constexpr basic_iterator operator++(int);
+        constexpr basic_iterator &operator--();
+        constexpr basic_iterator operator--(int);
+
+        constexpr bool operator==(const basic_iterator &rhv) const;
+
+    private:
+        constexpr basic_iterator(list_pointer list, index_type prev, index_type current);
+
+        list_pointer m_list = nullptr;
+        index_type m_prev = 0;
+        index_type m_current = 0;
+    };
+}
+#include "index_xor_list.hpp"
+#endif
@@ -0,0 +1,639 @@
+#ifndef XOR_INDEX_XOR_LIST_HPP
+#define XOR_INDEX_XOR_LIST_HPP
+#include "index_xor_list.h"
+
+namespace my_std
+{
+    template <typename T, typename Index>
+    constexpr index_xor_slot<T, Index>::index_xor_slot() : m_empty(), m_next_prev(0), m_live(false) {}
+
+    template <typename T, typename Index>
+    constexpr index_xor_slot<T, Index>::~index_xor_slot() {}
+
+    // =====================================inline slots ============================================
+
+    template <typename T, std::size_t N>
+    constexpr bool inline_xor_slots<T, N>::reserve(std::size_t count)
+    {
+        return count <= N;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr typename inline_xor_slots<T, N>::slot_type &inline_xor_slots<T, N>::operator[](std::size_t pos)
+    {
+        return m_slots[pos];
+    }
+
+    template <typename T, std::size_t N>
+    constexpr const typename inline_xor_slots<T, N>::slot_type &inline_xor_slots<T, N>::operator[](std::size_t pos) const
+    {
+        return m_slots[pos];
+    }
+
+    // =====================================heap slots ============================================
+
+    template <typename T>
+    constexpr heap_xor_slots<T>::~heap_xor_slots()
+    {
+        if (m_slots)
+        {
+            std::destroy_n(m_slots, m_capacity);
+            std::allocator<slot_type>().deallocate(m_slots, m_capacity);
+        }
+    }
+
+    template <typename T>
+    constexpr bool heap_xor_slots<T>::reserve(std::size_t count)
+    {
+        if (count <= m_capacity)
+        {
+            return true;
+        }
+
+        std::size_t capacity = m_capacity ? m_capacity * 2 : 8;
+        slot_type *slots = std::allocator<slot_type>().allocate(capacity);
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            std::construct_at(slots + i);
+        }
+        for (std::size_t i = 0; i < m_capacity; ++i)
+        {
+            slots[i].m_next_prev = m_slots[i].m_next_prev;
+            if (m_slots[i].m_live)
+            {
+                std::construct_at(std::addressof(slots[i].m_data), std::move(m_slots[i].m_data));
+                std::destroy_at(std::addressof(m_slots[i].m_data));
+                slots[i].m_live = true;
+            }
+        }
+        if (m_slots)
+        {
+            std::destroy_n(m_slots, m_capacity);
+            std::allocator<slot_type>().deallocate(m_slots, m_capacity);
+        }
+        m_slots = slots;
+        m_capacity = capacity;
+        return true;
+    }
+
+    template <typename T>
+    constexpr void heap_xor_slots<T>::swap(heap_xor_slots &rhv) noexcept
+    {
+        std::swap(m_slots, rhv.m_slots);
+        std::swap(m_capacity, rhv.m_capacity);
+    }
+
+    template <typename T>
+    constexpr typename heap_xor_slots<T>::slot_type &heap_xor_slots<T>::operator[](std::size_t pos)
+    {
+        return m_slots[pos];
+    }
+
+    template <typename T>
+    constexpr const typename heap_xor_slots<T>::slot_type &heap_xor_slots<T>::operator[](std::size_t pos) const
+    {
+        return m_slots[pos];
+    }
+
+    // =====================================index xor list ============================================
+
+    template <typename T, typename Storage>
+    constexpr index_xor_list<T, Storage>::index_xor_list(std::initializer_list<value_type> init)
+    {
+        for (const auto &elem : init)
+        {
+            push_back(elem);
+        }
+    }
+
+    template <typename T, typename Storage>
+    constexpr index_xor_list<T, Storage>::index_xor_list(const index_xor_list &rhv)
+    {
+        for (const auto &elem : rhv)
+        {
+            push_back(elem);
+        }
+    }
+
+    template <typename T, typename Storage>
+    constexpr index_xor_list<T, Storage>::index_xor_list(index_xor_list &&rhv) noexcept(Storage::steals || std::is_nothrow_move_constructible_v<T>)
+    {
+        if constexpr (Storage::steals)
+        {
+            m_slots.swap(rhv.m_slots);
+            m_used = std::exchange(rhv.m_used, 0);
+            m_free = std::exchange(rhv.m_free, 0);
+            m_head = std::exchange(rhv.m_head, 0);
+            m_tail = std::exchange(rhv.m_tail, 0);
+            m_size = std::exchange(rhv.m_size, 0);
+        }
+        else
+        {
+            for (auto &elem : rhv)
+            {
+                push_back(std::move(elem));
+            }
+            rhv.clear();
+        }
+    }
+
+    template <typename T, typename Storage>
+    constexpr index_xor_list<T, Storage>::~index_xor_list()
+    {
+        clear();
+    }
+
+    template <typename T, typename Storage>
+    constexpr index_xor_list<T, Storage> &index_xor_list<T, Storage>::operator=(const index_xor_list &rhv)
+    {
+        if (this == &rhv)
+        {
+            return *this;
+        }
+        clear();
+        for (const auto &elem : rhv)
+        {
+            push_back(elem);
+        }
+        return *this;
+    }
+
+    template <typename T, typename Storage>
+    constexpr index_xor_list<T, Storage> &index_xor_list<T, Storage>::operator=(index_xor_list &&rhv) noexcept(Storage::steals)
+    {
+        if (this == &rhv)
+        {
+            return *this;
+        }
+        if constexpr (Storage::steals)
+        {
+            index_xor_list tmp(std::move(rhv));
+            m_slots.swap(tmp.m_slots);
+            std::swap(m_used, tmp.m_used);
+            std::swap(m_free, tmp.m_free);
+            std::swap(m_head, tmp.m_head);
+            std::swap(m_tail, tmp.m_tail);
+            std::swap(m_size, tmp.m_size);
+        }
+        else
+        {
+            clear();
+            for (auto &elem : rhv)
+            {
+                push_back(std::move(elem));
+            }
+            rhv.clear();
+        }
+        return *this;
+    }
+
+    template <typename T, typename Storage>
+    constexpr typename index_xor_list<T, Storage>::Slot &index_xor_list<T, Storage>::slot(index_type index)
+    {
+        return m_slots[index - 1];
+    }
+
+    template <typename T, typename Storage>
+    constexpr const typename index_xor_list<T, Storage>::Slot &index_xor_list<T, Storage>::slot(index_type index) const
+    {
+        return m_slots[index - 1];
+    }
+
+    template <typename T, typename Storage>
+    template <typename... Args>
+    constexpr typename index_xor_list<T, Storage>::index_type index_xor_list<T, Storage>::acquire_slot(Args &&...args)
+    {
+        index_type index;
+        if (m_free)
+        {
+            index = m_free;
+        }
+        else if (m_slots.reserve(m_used + size_type(1)))
+        {
+            index = m_used + 1;
+        }
+        else
+        {
+            return 0;
+        }
+
+        Slot &s = slot(index);
+        std::construct_at(std::addressof(s.m_data), std::forward<Args>(args)...);
+        if (index == m_free)
+        {
+            m_free = s.m_next_prev;
+        }
+        else
+        {
+            ++m_used;
+        }
+        s.m_live = true;
+        s.m_next_prev = 0;
+        ++m_size;
+        return index;
+    }
+
+    template <typename T, typename Storage>
+    constexpr void index_xor_list<T, Storage>::release_slot(index_type index)
+    {
+        Slot &s = slot(index);
+        std::destroy_at(std::addressof(s.m_data));
+        std::construct_at(std::addressof(s.m_empty));
+        s.m_live = false;
+        s.m_next_prev = m_free;
+        m_free = index;
+        --m_size;
+    }
+
+    template <typename T, typename Storage>
+    constexpr void index_xor_list<T, Storage>::link_between(index_type prev, index_type next, index_type index)
+    {
+        slot(index).m_next_prev = prev ^ next;
+        if (prev)
+        {
+            slot(prev).m_next_prev ^= next ^ index;
+        }
+        else
+        {
+            m_head = index;
+        }
+        if (next)
+        {
+            slot(next).m_next_prev ^= prev ^ index;
+        }
+        else
+        {
+            m_tail = index;
+        }
+    }
+
+    template <typename T, typename Storage>
+    constexpr bool index_xor_list<T, Storage>::try_push_back(const_reference val)
+    {
+        index_type index = acquire_slot(val);
+        if (!index)
+        {
+            return false;
+        }
+        link_between(m_tail, 0, index);
+        return true;
+    }
+
+    template <typename T, typename Storage>
+    constexpr bool index_xor_list<T, Storage>::try_push_front(const_reference val)
+    {
+        index_type index = acquire_slot(val);
+        if (!index)
+        {
+            return false;
+        }
+        link_between(0, m_head, index);
+        return true;
+    }
+
+    template <typename T, typename Storage>
+    constexpr void index_xor_list<T, Storage>::push_back(const_reference val)
+    {
+        emplace_back(val);
+    }
+
+    template <typename T, typename Storage>
+    constexpr void index_xor_list<T, Storage>::push_back(value_type &&val)
+    {
+        emplace_back(std::move(val));
+    }
+
+    template <typename T, typename Storage>
+    constexpr void index_xor_list<T, Storage>::push_front(const_reference val)
+    {
+        emplace_front(val);
+    }
+
+    template <typename T, typename Storage>
+    constexpr void index_xor_list<T, Storage>::push_front(value_type &&val)
+    {
+        emplace_front(std::move(val));
+    }
+
+    template <typename T, typename Storage>
+    template <typename... Args>
+    constexpr typename index_xor_list<T, Storage>::reference index_xor_list<T, Storage>::emplace_back(Args &&...args)
+    {
+        return *emplace(end(), std::forward<Args>(args)...);
+    }
+
+    template <typename T, typename Storage>
+    template <typename... Args>
+    constexpr typename index_xor_list<T, Storage>::reference index_xor_list<T, Storage>::emplace_front(Args &&...args)
+    {
+        return *emplace(begin(), std::forward<Args>(args)...);
+    }
+
+    template <typename T, typename Storage>
+    constexpr void index_xor_list<T, Storage>::pop_back()
+    {
+        if (!m_tail)
+        {
+            throw std::logic_error("List is empty");
+        }
+        index_type prev = slot(m_tail).m_next_prev;
+        if (prev)
+        {
+            slot(prev).m_next_prev ^= m_tail;
+        }
+        release_slot(m_tail);
+        m_tail = prev;
+        if (!m_tail)
+        {
+            m_head = 0;
+        }
+    }
+
+    template <typename T, typename Storage>
+    constexpr void index_xor_list<T, Storage>::pop_front()
+    {
+        if (!m_head)
+        {
+            throw std::logic_error("List is empty");
+        }
+        index_type next = slot(m_head).m_next_prev;
+        if (next)
+        {
+            slot(next).m_next_prev ^= m_head;
+        }
+        release_slot(m_head);
+        m_head = next;
+        if (!m_head)
+        {
+            m_tail = 0;
+        }
+    }
+
+    template <typename T, typename Storage>
+    constexpr typename index_xor_list<T, Storage>::iterator index_xor_list<T, Storage>::insert(const_iterator pos, const_reference val)
+    {
+        return emplace(pos, val);
+    }
+
+    template <typename T, typename Storage>
+    constexpr typename index_xor_list<T, Storage>::iterator index_xor_list<T, Storage>::insert(const_iterator pos, value_type &&val)
+    {
+        return emplace(pos, std::move(val));
+    }
+
+    template <typename T, typename Storage>
+    template <typename... Args>
+    constexpr typename index_xor_list<T, Storage>::iterator index_xor_list<T, Storage>::emplace(const_iterator pos, Args &&...args)
+    {
+        index_type index = acquire_slot(std::forward<Args>(args)...);
+        if (!index)
+        {
+            throw std::logic_error("List is full");
+        }
+        link_between(pos.m_prev, pos.m_current, index);
+        return iterator(this, pos.m_prev, index);
+    }
+
+    template <typename T, typename Storage>
+    constexpr typename index_xor_list<T, Storage>::iterator index_xor_list<T, Storage>::erase(const_iterator pos)
+    {
+        if (!pos.m_current)
+        {
+            throw std::logic_error("Attempt to erase an invalid iterator");
+        }
+        index_type prev = pos.m_prev;
+        index_type current = pos.m_current;
+        index_type next = prev ^ slot(current).m_next_prev;
+        if (prev)
+        {
+            slot(prev).m_next_prev ^= current ^ next;
+        }
+        else
+        {
+            m_head = next;
+        }
+        if (next)
+        {
+            slot(next).m_next_prev ^= current ^ prev;
+        }
+        else
+        {
+            m_tail = prev;
+        }
+        release_slot(current);
+        return iterator(this, prev, next);
+    }
+
+    template <typename T, typename Storage>
+    constexpr void index_xor_list<T, Storage>::clear()
+    {
+        while (m_head)
+        {
+            pop_front();
+        }
+        m_used = 0;
+        m_free = 0;
+    }
+
+    template <typename T, typename Storage>
+    constexpr void index_xor_list<T, Storage>::reverse()
+    {
+        std::swap(m_head, m_tail);
+    }
+
+    template <typename T, typename Storage>
+    constexpr typename index_xor_list<T, Storage>::reference index_xor_list<T, Storage>::front()
+    {
+        if (!m_head)
+        {
+            throw std::logic_error("List is empty");
+        }
+        return slot(m_head).m_data;
+    }
+
+    template <typename T, typename Storage>
+    constexpr typename index_xor_list<T, Storage>::const_reference index_xor_list<T, Storage>::front() const
+    {
+        if (!m_head)
+        {
+            throw std::logic_error("List is empty");
+        }
+        return slot(m_head).m_data;
+    }
+
+    template <typename T, typename Storage>
+    constexpr typename index_xor_list<T, Storage>::reference index_xor_list<T, Storage>::back()
+    {
+        if (!m_tail)
+        {
+            throw std::logic_error("List is empty");
+        }
+        return slot(m_tail).m_data;
+    }
+
+    template <typename T, typename Storage>
+    constexpr typename index_xor_list<T, Storage>::const_reference index_xor_list<T, Storage>::back() const
+    {
+        if (!m_tail)
+        {
+            throw std::logic_error("List is empty");
+        }
+        return slot(m_tail).m_data;
+    }
+
+    template <typename T, typename Storage>
+    constexpr typename index_xor_list<T, Storage>::size_type index_xor_list<T, Storage>::size() const
+    {
+        return m_size;
+    }
+
+    template <typename T, typename Storage>
+    constexpr bool index_xor_list<T, Storage>::empty() const
+    {
+        return m_size == 0;
+    }
+
+    template <typename T, typename Storage>
+    constexpr bool index_xor_list<T, Storage>::contains(const_reference val) const
+    {
+        for (const auto &elem : *this)
+        {
+            if (elem == val)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename T, typename Storage>
+    constexpr typename index_xor_list<T, Storage>::iterator index_xor_list<T, Storage>::begin()
+    {
+        return iterator(this, 0, m_head);
+    }
+
+    template <typename T, typename Storage>
+    constexpr typename index_xor_list<T, Storage>::const_iterator index_xor_list<T, Storage>::begin() const
+    {
+        return const_iterator(this, 0, m_head);
+    }
+
+    template <typename T, typename Storage>
+    constexpr typename index_xor_list<T, Storage>::iterator index_xor_list<T, Storage>::end()
+    {
+        return iterator(this, m_tail, 0);
+    }
+
+    template <typename T, typename Storage>
+    constexpr typename index_xor_list<T, Storage>::const_iterator index_xor_list<T, Storage>::end() const
+    {
+        return const_iterator(this, m_tail, 0);
+    }
+
+    template <typename T, typename Storage>
+    constexpr bool index_xor_list<T, Storage>::operator==(const index_xor_list &rhv) const
+    {
+        if (m_size != rhv.m_size)
+        {
+            return false;
+        }
+        for (auto l = begin(), r = rhv.begin(); l != end(); ++l, ++r)
+        {
+            if (!(*l == *r))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // =====================================iterator ============================================
+
+    template <typename T, typename Storage>
+    template <bool Const>
+    constexpr index_xor_list<T, Storage>::basic_iterator<Const>::basic_iterator(list_pointer list, index_type prev, index_type current)
+        : m_list(list), m_prev(prev), m_current(current)
+    {
+    }
+
+    template <typename T, typename Storage>
+    template <bool Const>
+    template <bool OtherConst>
+        requires(Const && !OtherConst)
+    constexpr index_xor_list<T, Storage>::basic_iterator<Const>::basic_iterator(const basic_iterator<OtherConst> &rhv)
+        : m_list(rhv.m_list), m_prev(rhv.m_prev), m_current(rhv.m_current)
+    {
+    }
+
+    template <typename T, typename Storage>
+    template <bool Const>
+    constexpr typename index_xor_list<T, Storage>::template basic_iterator<Const>::reference index_xor_list<T, Storage>::basic_iterator<Const>::operator*() const
+    {
+        if (!m_current)
+        {
+            throw std::logic_error("Trying to dereference an invalid iterator");
+        }
+        return m_list->slot(m_current).m_data;
+    }
+
+    template <typename T, typename Storage>
+    template <bool Const>
+    constexpr typename index_xor_list<T, Storage>::template basic_iterator<Const>::pointer index_xor_list<T, Storage>::basic_iterator<Const>::operator->() const
+    {
+        return std::addressof(**this);
+    }
+
+    template <typename T, typename Storage>
+    template <bool Const>
+    constexpr typename index_xor_list<T, Storage>::template basic_iterator<Const> &index_xor_list<T, Storage>::basic_iterator<Const>::operator++()
+    {
+        if (!m_current)
+        {
+            throw std::logic_error("Incrementing an invalid iterator");
+        }
+        index_type next = m_prev ^ m_list->slot(m_current).m_next_prev;
+        m_prev = m_current;
+        m_current = next;
+        return *this;
+    }
+
+    template <typename T, typename Storage>
+    template <bool Const>
+    constexpr typename index_xor_list<T, Storage>::template basic_iterator<Const> index_xor_list<T, Storage>::basic_iterator<Const>::operator++(int)
+    {
+        basic_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    template <typename T, typename Storage>
+    template <bool Const>
+    constexpr typename index_xor_list<T, Storage>::template basic_iterator<Const> &index_xor_list<T, Storage>::basic_iterator<Const>::operator--()
+    {
+        if (!m_prev)
+        {
+            throw std::logic_error("Decrementing an invalid iterator");
+        }
+        index_type next = m_current;
+        m_current = m_prev;
+        m_prev = m_list->slot(m_current).m_next_prev ^ next;
+        return *this;
+    }
+
+    template <typename T, typename Storage>
+    template <bool Const>
+    constexpr typename index_xor_list<T, Storage>::template basic_iterator<Const> index_xor_list<T, Storage>::basic_iterator<Const>::operator--(int)
+    {
+        basic_iterator tmp = *this;
+        --(*this);
+        return tmp;
+    }
+
+    template <typename T, typename Storage>
+    template <bool Const>
+    constexpr bool index_xor_list<T, Storage>::basic_iterator<Const>::operator==(const basic_iterator &rhv) const
+    {
+        return m_current == rhv.m_current;
+    }
+}
+#endif
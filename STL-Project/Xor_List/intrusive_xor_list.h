@@ -0,0 +1,146 @@
+#ifndef XOR_INTRUSIVE_XOR_LIST_H
+#define XOR_INTRUSIVE_XOR_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "xor_chain.h"
+
+namespace my_std
+{
+    struct xor_hook
+    {
+        xor_hook *m_next_prev = nullptr;
+    };
+
+    // Links objects that embed an xor_hook instead of owning nodes. Inserting
+    // never allocates or copies and unlinking never destroys; the caller owns
+    // the objects and must keep them alive, and in at most one list per
+    // hook, while they are linked. Destroying the list unlinks every object.
+    template <typename T, xor_hook T::*Hook>
+    class intrusive_xor_list
+    {
+    public:
+        class iterator;
+        class const_iterator;
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T &;
+        using const_reference = const T &;
+
+    public:
+        intrusive_xor_list() = default;
+        intrusive_xor_list(const intrusive_xor_list &) = delete;
+        intrusive_xor_list &operator=(const intrusive_xor_list &) = delete;
+        intrusive_xor_list(intrusive_xor_list &&rhv) noexcept;
+        intrusive_xor_list &operator=(intrusive_xor_list &&rhv) noexcept;
+        ~intrusive_xor_list();
+
+    public:
+        void push_back(reference obj);
+        void push_front(reference obj);
+        void pop_back();
+        void pop_front();
+        iterator erase(iterator pos);
+        void clear();
+
+        reference front();
+        const_reference front() const;
+        reference back();
+        const_reference back() const;
+        size_type size() const;
+        bool empty() const;
+
+        void reverse();
+        void splice_back(intrusive_xor_list &other);
+        void merge(intrusive_xor_list &other);
+        template <typename Compare>
+        void merge(intrusive_xor_list &other, Compare comp);
+        void sort();
+        template <typename Compare>
+        void sort(Compare comp);
+
+        iterator begin();
+        const_iterator begin() const;
+        iterator end();
+        const_iterator end() const;
+
+    private:
+        using chain = xor_chain<xor_hook>;
+
+        static xor_hook *hook_of(const_reference obj);
+        static std::ptrdiff_t hook_offset();
+        static T &object_of(xor_hook *hook);
+
+        void unlink(xor_hook *prev, xor_hook *node);
+
+    private:
+        xor_hook *m_head = nullptr;
+        xor_hook *m_tail = nullptr;
+        size_type m_size = 0;
+    };
+
+    template <typename T, xor_hook T::*Hook>
+    class intrusive_xor_list<T, Hook>::const_iterator
+    {
+        friend class intrusive_xor_list<T, Hook>;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+    public:
+        const_iterator() = default;
+
+        reference operator*() const;
+        pointer operator->() const;
+
+        const_iterator &operator++();
+        const_iterator operator++(int);
+        const_iterator &operator--();
+        const_iterator operator--(int);
+
+        bool operator==(const const_iterator &rhv) const;
+
+    protected:
+        const_iterator(xor_hook *prev, xor_hook *current);
+
+        xor_hook *m_prev = nullptr;
+        xor_hook *m_current = nullptr;
+    };
+
+    template <typename T, xor_hook T::*Hook>
+    class intrusive_xor_list<T, Hook>::iterator : public intrusive_xor_list<T, Hook>::const_iterator
+    {
+        friend class intrusive_xor_list<T, Hook>;
+
+    public:
+        using pointer = T *;
+        using reference = T &;
+
+    public:
+        iterator() = default;
+
+        reference operator*() const;
+        pointer operator->() const;
+
+        iterator &operator++();
+        iterator operator++(int);
+        iterator &operator--();
+        iterator operator--(int);
+
+    private:
+        iterator(xor_hook *prev, xor_hook *current);
+    };
+}
+#include "intrusive_xor_list.hpp"
+#endif
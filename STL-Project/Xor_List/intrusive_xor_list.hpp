@@ -0,0 +1,416 @@
+#ifndef XOR_INTRUSIVE_XOR_LIST_HPP
+#define XOR_INTRUSIVE_XOR_LIST_HPP
+#include "intrusive_xor_list.h"
+
+namespace my_std
+{
+    template <typename T, xor_hook T::*Hook>
+    intrusive_xor_list<T, Hook>::intrusive_xor_list(intrusive_xor_list &&rhv) noexcept
+        : m_head(std::exchange(rhv.m_head, nullptr)), m_tail(std::exchange(rhv.m_tail, nullptr)), m_size(std::exchange(rhv.m_size, 0))
+    {
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    intrusive_xor_list<T, Hook> &intrusive_xor_list<T, Hook>::operator=(intrusive_xor_list &&rhv) noexcept
+    {
+        if (this == &rhv)
+        {
+            return *this;
+        }
+        clear();
+        m_head = std::exchange(rhv.m_head, nullptr);
+        m_tail = std::exchange(rhv.m_tail, nullptr);
+        m_size = std::exchange(rhv.m_size, 0);
+        return *this;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    intrusive_xor_list<T, Hook>::~intrusive_xor_list()
+    {
+        clear();
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    void intrusive_xor_list<T, Hook>::push_back(reference obj)
+    {
+        chain::link_back(m_head, m_tail, hook_of(obj));
+        ++m_size;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    void intrusive_xor_list<T, Hook>::push_front(reference obj)
+    {
+        xor_hook *node = hook_of(obj);
+        node->m_next_prev = m_head;
+        if (m_head)
+        {
+            m_head->m_next_prev = chain::XOR(m_head->m_next_prev, node);
+        }
+        else
+        {
+            m_tail = node;
+        }
+        m_head = node;
+        ++m_size;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    void intrusive_xor_list<T, Hook>::pop_back()
+    {
+        if (!m_tail)
+        {
+            throw std::logic_error("List is empty");
+        }
+        unlink(m_tail->m_next_prev, m_tail);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    void intrusive_xor_list<T, Hook>::pop_front()
+    {
+        if (!m_head)
+        {
+            throw std::logic_error("List is empty");
+        }
+        unlink(nullptr, m_head);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::iterator intrusive_xor_list<T, Hook>::erase(iterator pos)
+    {
+        if (!pos.m_current)
+        {
+            throw std::logic_error("Attempt to erase an invalid iterator");
+        }
+        xor_hook *next = chain::XOR(pos.m_prev, pos.m_current->m_next_prev);
+        unlink(pos.m_prev, pos.m_current);
+        return iterator(pos.m_prev, next);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    void intrusive_xor_list<T, Hook>::clear()
+    {
+        xor_hook *prev = nullptr;
+        xor_hook *current = m_head;
+        while (current)
+        {
+            xor_hook *next = chain::XOR(prev, current->m_next_prev);
+            if (prev)
+            {
+                prev->m_next_prev = nullptr;
+            }
+            prev = current;
+            current = next;
+        }
+        if (prev)
+        {
+            prev->m_next_prev = nullptr;
+        }
+        m_head = nullptr;
+        m_tail = nullptr;
+        m_size = 0;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::reference intrusive_xor_list<T, Hook>::front()
+    {
+        if (!m_head)
+        {
+            throw std::logic_error("List is empty");
+        }
+        return object_of(m_head);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::const_reference intrusive_xor_list<T, Hook>::front() const
+    {
+        if (!m_head)
+        {
+            throw std::logic_error("List is empty");
+        }
+        return object_of(m_head);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::reference intrusive_xor_list<T, Hook>::back()
+    {
+        if (!m_tail)
+        {
+            throw std::logic_error("List is empty");
+        }
+        return object_of(m_tail);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::const_reference intrusive_xor_list<T, Hook>::back() const
+    {
+        if (!m_tail)
+        {
+            throw std::logic_error("List is empty");
+        }
+        return object_of(m_tail);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::size_type intrusive_xor_list<T, Hook>::size() const
+    {
+        return m_size;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    bool intrusive_xor_list<T, Hook>::empty() const
+    {
+        return m_size == 0;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    void intrusive_xor_list<T, Hook>::reverse()
+    {
+        std::swap(m_head, m_tail);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    void intrusive_xor_list<T, Hook>::splice_back(intrusive_xor_list &other)
+    {
+        if (this == std::addressof(other))
+        {
+            return;
+        }
+        chain::append(m_head, m_tail, other.m_head, other.m_tail);
+        m_size += other.m_size;
+        other.m_head = nullptr;
+        other.m_tail = nullptr;
+        other.m_size = 0;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    void intrusive_xor_list<T, Hook>::merge(intrusive_xor_list &other)
+    {
+        merge(other, std::less<>());
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    template <typename Compare>
+    void intrusive_xor_list<T, Hook>::merge(intrusive_xor_list &other, Compare comp)
+    {
+        if (this == std::addressof(other) || !other.m_head)
+        {
+            return;
+        }
+
+        chain::merge(m_head, m_tail, m_head, m_tail, other.m_head, other.m_tail, [&comp](xor_hook *a, xor_hook *b)
+                     { return comp(object_of(a), object_of(b)); });
+        m_size += other.m_size;
+        other.m_head = nullptr;
+        other.m_tail = nullptr;
+        other.m_size = 0;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    void intrusive_xor_list<T, Hook>::sort()
+    {
+        sort(std::less<>());
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    template <typename Compare>
+    void intrusive_xor_list<T, Hook>::sort(Compare comp)
+    {
+        chain::sort(m_head, m_tail, m_size, [&comp](xor_hook *a, xor_hook *b)
+                    { return comp(object_of(a), object_of(b)); });
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::iterator intrusive_xor_list<T, Hook>::begin()
+    {
+        return iterator(nullptr, m_head);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::const_iterator intrusive_xor_list<T, Hook>::begin() const
+    {
+        return const_iterator(nullptr, m_head);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::iterator intrusive_xor_list<T, Hook>::end()
+    {
+        return iterator(m_tail, nullptr);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::const_iterator intrusive_xor_list<T, Hook>::end() const
+    {
+        return const_iterator(m_tail, nullptr);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    xor_hook *intrusive_xor_list<T, Hook>::hook_of(const_reference obj)
+    {
+        return const_cast<xor_hook *>(std::addressof(obj.*Hook));
+    }
+
+    // The hook's offset inside T, taken once from an object that is never
+    // constructed.
+    template <typename T, xor_hook T::*Hook>
+    std::ptrdiff_t intrusive_xor_list<T, Hook>::hook_offset()
+    {
+        static const std::ptrdiff_t offset = []
+        {
+            union probe_type
+            {
+                probe_type() {}
+                ~probe_type() {}
+                T m_object;
+            } probe;
+            return reinterpret_cast<unsigned char *>(std::addressof(probe.m_object.*Hook)) - reinterpret_cast<unsigned char *>(std::addressof(probe.m_object));
+        }();
+        return offset;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    T &intrusive_xor_list<T, Hook>::object_of(xor_hook *hook)
+    {
+        return *reinterpret_cast<T *>(reinterpret_cast<unsigned char *>(hook) - hook_offset());
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    void intrusive_xor_list<T, Hook>::unlink(xor_hook *prev, xor_hook *node)
+    {
+        xor_hook *next = chain::XOR(prev, node->m_next_prev);
+        if (prev)
+        {
+            prev->m_next_prev = chain::XOR(chain::XOR(prev->m_next_prev, node), next);
+        }
+        else
+        {
+            m_head = next;
+        }
+        if (next)
+        {
+            next->m_next_prev = chain::XOR(chain::XOR(next->m_next_prev, node), prev);
+        }
+        else
+        {
+            m_tail = prev;
+        }
+        node->m_next_prev = nullptr;
+        --m_size;
+    }
+
+    // =====================================const iterator ============================================
+
+    template <typename T, xor_hook T::*Hook>
+    intrusive_xor_list<T, Hook>::const_iterator::const_iterator(xor_hook *prev, xor_hook *current) : m_prev(prev), m_current(current) {}
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::const_iterator::reference intrusive_xor_list<T, Hook>::const_iterator::operator*() const
+    {
+        if (!m_current)
+        {
+            throw std::logic_error("Trying to dereference an invalid iterator");
+        }
+        return object_of(m_current);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::const_iterator::pointer intrusive_xor_list<T, Hook>::const_iterator::operator->() const
+    {
+        return std::addressof(**this);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::const_iterator &intrusive_xor_list<T, Hook>::const_iterator::operator++()
+    {
+        if (!m_current)
+        {
+            throw std::logic_error("Incrementing an invalid iterator");
+        }
+        xor_hook *next = chain::XOR(m_prev, m_current->m_next_prev);
+        m_prev = m_current;
+        m_current = next;
+        return *this;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::const_iterator intrusive_xor_list<T, Hook>::const_iterator::operator++(int)
+    {
+        const_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::const_iterator &intrusive_xor_list<T, Hook>::const_iterator::operator--()
+    {
+        if (!m_prev)
+        {
+            throw std::logic_error("Decrementing an invalid iterator");
+        }
+        xor_hook *next = m_current;
+        m_current = m_prev;
+        m_prev = chain::XOR(m_current->m_next_prev, next);
+        return *this;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::const_iterator intrusive_xor_list<T, Hook>::const_iterator::operator--(int)
+    {
+        const_iterator tmp = *this;
+        --(*this);
+        return tmp;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    bool intrusive_xor_list<T, Hook>::const_iterator::operator==(const const_iterator &rhv) const
+    {
+        return m_current == rhv.m_current;
+    }
+
+    // =====================================iterator ============================================
+
+    template <typename T, xor_hook T::*Hook>
+    intrusive_xor_list<T, Hook>::iterator::iterator(xor_hook *prev, xor_hook *current) : const_iterator(prev, current) {}
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::iterator::reference intrusive_xor_list<T, Hook>::iterator::operator*() const
+    {
+        return const_cast<reference>(const_iterator::operator*());
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::iterator::pointer intrusive_xor_list<T, Hook>::iterator::operator->() const
+    {
+        return std::addressof(**this);
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::iterator &intrusive_xor_list<T, Hook>::iterator::operator++()
+    {
+        const_iterator::operator++();
+        return *this;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::iterator intrusive_xor_list<T, Hook>::iterator::operator++(int)
+    {
+        iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::iterator &intrusive_xor_list<T, Hook>::iterator::operator--()
+    {
+        const_iterator::operator--();
+        return *this;
+    }
+
+    template <typename T, xor_hook T::*Hook>
+    typename intrusive_xor_list<T, Hook>::iterator intrusive_xor_list<T, Hook>::iterator::operator--(int)
+    {
+        iterator tmp = *this;
+        --(*this);
+        return tmp;
+    }
+}
+#endif
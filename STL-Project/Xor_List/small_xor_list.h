@@ -0,0 +1,142 @@
+#ifndef XOR_SMALL_XOR_LIST_H
+#define XOR_SMALL_XOR_LIST_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "xor_list.h"
+
+namespace my_std
+{
+    template <std::size_t SlotSize, std::size_t SlotAlign, std::size_t N>
+    class inline_node_buffer
+    {
+        static_assert(N > 0 && N <= 64, "inline_node_buffer holds between 1 and 64 slots");
+
+    public:
+        static constexpr std::size_t slot_size = SlotSize;
+        static constexpr std::size_t slot_align = SlotAlign;
+
+    public:
+        inline_node_buffer() = default;
+        inline_node_buffer(const inline_node_buffer &) = delete;
+        inline_node_buffer &operator=(const inline_node_buffer &) = delete;
+
+        void *acquire();
+        bool release(void *ptr);
+        bool owns(const void *ptr) const;
+        bool in_use() const;
+
+    private:
+        alignas(SlotAlign) unsigned char m_storage[SlotSize * N];
+        std::uint64_t m_used = 0;
+    };
+
+    template <typename T, typename Buffer>
+    class inline_buffer_allocator
+    {
+        template <typename U, typename B>
+        friend class inline_buffer_allocator;
+
+    public:
+        template <typename U>
+        struct rebind
+        {
+            using other = inline_buffer_allocator<U, Buffer>;
+        };
+
+    public:
+        inline_buffer_allocator() = default;
+        explicit inline_buffer_allocator(Buffer *buffer);
+        template <typename U>
+        inline_buffer_allocator(const inline_buffer_allocator<U, Buffer> &rhv);
+
+        T *allocate();
+        template <typename... Args>
+        void construct(T *ptr, Args &&...args);
+        void destroy(T *ptr);
+        void deallocate(T *ptr);
+
+        template <typename U>
+        bool operator==(const inline_buffer_allocator<U, Buffer> &rhv) const;
+
+    private:
+        Buffer *m_buffer = nullptr;
+    };
+
+    // The first N nodes live in a buffer inside the object; only nodes
+    // beyond that reach the heap. Because inline nodes belong to this
+    // object, the underlying xor_list is never handed out. A move relinks
+    // the heap nodes as they are and moves only the elements of the inline
+    // ones into the target's buffer, which always has room for them.
+    template <typename T, std::size_t N = 8>
+    class small_xor_list
+    {
+        // xor_list's node does not depend on the allocator, so the default
+        // list's node sizes the slots of the one built on them.
+        using node_type = typename xor_list<T>::Node;
+
+    public:
+        using buffer_type = inline_node_buffer<sizeof(node_type), alignof(node_type), N>;
+        using allocator_type = inline_buffer_allocator<T, buffer_type>;
+        using list_type = xor_list<T, allocator_type>;
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using iterator = typename list_type::iterator;
+        using const_iterator = typename list_type::const_iterator;
+        using reverse_iterator = typename list_type::reverse_iterator;
+        using const_reverse_iterator = typename list_type::const_reverse_iterator;
+
+    public:
+        small_xor_list();
+        small_xor_list(std::initializer_list<value_type> init);
+        small_xor_list(const small_xor_list &rhv);
+        small_xor_list(small_xor_list &&rhv) noexcept(std::is_nothrow_move_constructible_v<T>);
+        small_xor_list &operator=(const small_xor_list &rhv);
+        small_xor_list &operator=(small_xor_list &&rhv) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    public:
+        void push_back(const_reference val);
+        void push_back(value_type &&val);
+        void push_front(const_reference val);
+        void pop_back();
+        void pop_front();
+        void clear();
+        void reverse();
+        void sort();
+        void swap(small_xor_list &rhv);
+
+        reference front();
+        const_reference front() const;
+        reference back();
+        const_reference back() const;
+        size_type size() const;
+        bool empty() const;
+
+        iterator begin();
+        const_iterator begin() const;
+        iterator end();
+        const_iterator end() const;
+        reverse_iterator rbegin();
+        const_reverse_iterator rbegin() const;
+        reverse_iterator rend();
+        const_reverse_iterator rend() const;
+
+        bool operator==(const small_xor_list &rhv) const;
+
+    private:
+        void take(small_xor_list &rhv) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    private:
+        buffer_type m_buffer;
+        list_type m_list;
+
+        static_assert(sizeof(typename list_type::Node) <= buffer_type::slot_size && alignof(typename list_type::Node) <= buffer_type::slot_align,
+                      "inline slots must hold the list's node");
+    };
+}
+#include "small_xor_list.hpp"
+#endif
@@ -0,0 +1,351 @@
+#ifndef XOR_SMALL_XOR_LIST_HPP
+#define XOR_SMALL_XOR_LIST_HPP
+#include "small_xor_list.h"
+
+namespace my_std
+{
+    template <std::size_t SlotSize, std::size_t SlotAlign, std::size_t N>
+    void *inline_node_buffer<SlotSize, SlotAlign, N>::acquire()
+    {
+        std::uint64_t free = ~m_used;
+        if constexpr (N < 64)
+        {
+            free &= (std::uint64_t(1) << N) - 1;
+        }
+        if (!free)
+        {
+            return nullptr;
+        }
+        int slot = std::countr_zero(free);
+        m_used |= std::uint64_t(1) << slot;
+        return m_storage + slot * SlotSize;
+    }
+
+    template <std::size_t SlotSize, std::size_t SlotAlign, std::size_t N>
+    bool inline_node_buffer<SlotSize, SlotAlign, N>::release(void *ptr)
+    {
+        if (!owns(ptr))
+        {
+            return false;
+        }
+        std::uintptr_t offset = reinterpret_cast<std::uintptr_t>(ptr) - reinterpret_cast<std::uintptr_t>(m_storage);
+        m_used &= ~(std::uint64_t(1) << (offset / SlotSize));
+        return true;
+    }
+
+    template <std::size_t SlotSize, std::size_t SlotAlign, std::size_t N>
+    bool inline_node_buffer<SlotSize, SlotAlign, N>::owns(const void *ptr) const
+    {
+        std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(m_storage);
+        std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(ptr);
+        return addr >= begin && addr < begin + sizeof(m_storage);
+    }
+
+    template <std::size_t SlotSize, std::size_t SlotAlign, std::size_t N>
+    bool inline_node_buffer<SlotSize, SlotAlign, N>::in_use() const
+    {
+        return m_used != 0;
+    }
+
+    // =====================================inline buffer allocator ============================================
+
+    template <typename T, typename Buffer>
+    inline_buffer_allocator<T, Buffer>::inline_buffer_allocator(Buffer *buffer) : m_buffer(buffer) {}
+
+    template <typename T, typename Buffer>
+    template <typename U>
+    inline_buffer_allocator<T, Buffer>::inline_buffer_allocator(const inline_buffer_allocator<U, Buffer> &rhv) : m_buffer(rhv.m_buffer) {}
+
+    template <typename T, typename Buffer>
+    T *inline_buffer_allocator<T, Buffer>::allocate()
+    {
+        if constexpr (sizeof(T) <= Buffer::slot_size && alignof(T) <= Buffer::slot_align)
+        {
+            if (m_buffer)
+            {
+                if (void *slot = m_buffer->acquire())
+                {
+                    return static_cast<T *>(slot);
+                }
+            }
+        }
+        return static_cast<T *>(std::malloc(sizeof(T)));
+    }
+
+    template <typename T, typename Buffer>
+    template <typename... Args>
+    void inline_buffer_allocator<T, Buffer>::construct(T *ptr, Args &&...args)
+    {
+        ::new (ptr) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T, typename Buffer>
+    void inline_buffer_allocator<T, Buffer>::destroy(T *ptr)
+    {
+        ptr->~T();
+    }
+
+    template <typename T, typename Buffer>
+    void inline_buffer_allocator<T, Buffer>::deallocate(T *ptr)
+    {
+        if (!m_buffer || !m_buffer->release(ptr))
+        {
+            std::free(ptr);
+        }
+    }
+
+    template <typename T, typename Buffer>
+    template <typename U>
+    bool inline_buffer_allocator<T, Buffer>::operator==(const inline_buffer_allocator<U, Buffer> &rhv) const
+    {
+        return m_buffer == rhv.m_buffer;
+    }
+
+    // =====================================small xor list ============================================
+
+    template <typename T, std::size_t N>
+    small_xor_list<T, N>::small_xor_list() : m_list(allocator_type(&m_buffer)) {}
+
+    template <typename T, std::size_t N>
+    small_xor_list<T, N>::small_xor_list(std::initializer_list<value_type> init) : small_xor_list()
+    {
+        for (const auto &elem : init)
+        {
+            m_list.push_back(elem);
+        }
+    }
+
+    template <typename T, std::size_t N>
+    small_xor_list<T, N>::small_xor_list(const small_xor_list &rhv) : small_xor_list()
+    {
+        for (const auto &elem : rhv.m_list)
+        {
+            m_list.push_back(elem);
+        }
+    }
+
+    template <typename T, std::size_t N>
+    small_xor_list<T, N>::small_xor_list(small_xor_list &&rhv) noexcept(std::is_nothrow_move_constructible_v<T>) : small_xor_list()
+    {
+        take(rhv);
+    }
+
+    template <typename T, std::size_t N>
+    small_xor_list<T, N> &small_xor_list<T, N>::operator=(const small_xor_list &rhv)
+    {
+        if (this == &rhv)
+        {
+            return *this;
+        }
+        m_list.clear();
+        for (const auto &elem : rhv.m_list)
+        {
+            m_list.push_back(elem);
+        }
+        return *this;
+    }
+
+    template <typename T, std::size_t N>
+    small_xor_list<T, N> &small_xor_list<T, N>::operator=(small_xor_list &&rhv) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this == &rhv)
+        {
+            return *this;
+        }
+        m_list.clear();
+        take(rhv);
+        return *this;
+    }
+
+    template <typename T, std::size_t N>
+    void small_xor_list<T, N>::take(small_xor_list &rhv) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        // This list is empty, so its buffer has a free slot for every inline
+        // node of rhv. Heap nodes came from malloc and any allocator frees
+        // them, so they keep their address and only get new links.
+        using node = typename list_type::Node;
+        using chain = typename list_type::chain;
+        list_type &from = rhv.m_list;
+        node *head = nullptr;
+        node *tail = nullptr;
+        node *prev = nullptr;
+        node *current = from.m_head;
+        while (current)
+        {
+            node *next = chain::XOR(prev, current->m_next_prev);
+            node *kept = current;
+            if (rhv.m_buffer.owns(current))
+            {
+                kept = ::new (m_buffer.acquire()) node(std::move(current->m_data));
+                if (current->m_next_prev.erased())
+                {
+                    kept->m_next_prev.mark_erased();
+                }
+                current->~node();
+                rhv.m_buffer.release(current);
+            }
+            chain::link_back(head, tail, kept);
+            prev = current;
+            current = next;
+        }
+        m_list.m_head = head;
+        m_list.m_tail = tail;
+        m_list.m_size = from.m_size;
+        m_list.m_tombstones = from.m_tombstones;
+        from.m_head = nullptr;
+        from.m_tail = nullptr;
+        from.m_size = 0;
+        from.m_tombstones = 0;
+    }
+
+    template <typename T, std::size_t N>
+    void small_xor_list<T, N>::push_back(const_reference val)
+    {
+        m_list.push_back(val);
+    }
+
+    template <typename T, std::size_t N>
+    void small_xor_list<T, N>::push_back(value_type &&val)
+    {
+        m_list.push_back(std::move(val));
+    }
+
+    template <typename T, std::size_t N>
+    void small_xor_list<T, N>::push_front(const_reference val)
+    {
+        m_list.push_front(val);
+    }
+
+    template <typename T, std::size_t N>
+    void small_xor_list<T, N>::pop_back()
+    {
+        m_list.pop_back();
+    }
+
+    template <typename T, std::size_t N>
+    void small_xor_list<T, N>::pop_front()
+    {
+        m_list.pop_front();
+    }
+
+    template <typename T, std::size_t N>
+    void small_xor_list<T, N>::clear()
+    {
+        m_list.clear();
+    }
+
+    template <typename T, std::size_t N>
+    void small_xor_list<T, N>::reverse()
+    {
+        m_list.reverse();
+    }
+
+    template <typename T, std::size_t N>
+    void small_xor_list<T, N>::sort()
+    {
+        m_list.sort();
+    }
+
+    template <typename T, std::size_t N>
+    void small_xor_list<T, N>::swap(small_xor_list &rhv)
+    {
+        if (this == &rhv)
+        {
+            return;
+        }
+        small_xor_list tmp(std::move(rhv));
+        rhv = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    template <typename T, std::size_t N>
+    typename small_xor_list<T, N>::reference small_xor_list<T, N>::front()
+    {
+        return m_list.front();
+    }
+
+    template <typename T, std::size_t N>
+    typename small_xor_list<T, N>::const_reference small_xor_list<T, N>::front() const
+    {
+        return m_list.front();
+    }
+
+    template <typename T, std::size_t N>
+    typename small_xor_list<T, N>::reference small_xor_list<T, N>::back()
+    {
+        return m_list.back();
+    }
+
+    template <typename T, std::size_t N>
+    typename small_xor_list<T, N>::const_reference small_xor_list<T, N>::back() const
+    {
+        return m_list.back();
+    }
+
+    template <typename T, std::size_t N>
+    typename small_xor_list<T, N>::size_type small_xor_list<T, N>::size() const
+    {
+        return m_list.size();
+    }
+
+    template <typename T, std::size_t N>
+    bool small_xor_list<T, N>::empty() const
+    {
+        return m_list.empty();
+    }
+
+    template <typename T, std::size_t N>
+    typename small_xor_list<T, N>::iterator small_xor_list<T, N>::begin()
+    {
+        return m_list.begin();
+    }
+
+    template <typename T, std::size_t N>
+    typename small_xor_list<T, N>::const_iterator small_xor_list<T, N>::begin() const
+    {
+        return m_list.begin();
+    }
+
+    template <typename T, std::size_t N>
+    typename small_xor_list<T, N>::iterator small_xor_list<T, N>::end()
+    {
+        return m_list.end();
+    }
+
+    template <typename T, std::size_t N>
+    typename small_xor_list<T, N>::const_iterator small_xor_list<T, N>::end() const
+    {
+        return m_list.end();
+    }
+
+    template <typename T, std::size_t N>
+    typename small_xor_list<T, N>::reverse_iterator small_xor_list<T, N>::rbegin()
+    {
+        return m_list.rbegin();
+    }
+
+    template <typename T, std::size_t N>
+    typename small_xor_list<T, N>::const_reverse_iterator small_xor_list<T, N>::rbegin() const
+    {
+        return m_list.rbegin();
+    }
+
+    template <typename T, std::size_t N>
+    typename small_xor_list<T, N>::reverse_iterator small_xor_list<T, N>::rend()
+    {
+        return m_list.rend();
+    }
+
+    template <typename T, std::size_t N>
+    typename small_xor_list<T, N>::const_reverse_iterator small_xor_list<T, N>::rend() const
+    {
+        return m_list.rend();
+    }
+
+    template <typename T, std::size_t N>
+    bool small_xor_list<T, N>::operator==(const small_xor_list &rhv) const
+    {
+        return m_list == rhv.m_list;
+    }
+}
+#endif
@@ -0,0 +1,33 @@
+#ifndef XOR_STATIC_XOR_LIST_H
+#define XOR_STATIC_XOR_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include "index_xor_list.h"
+
+namespace my_std
+{
+    // Fixed-capacity list whose N slots live inside the object, so no member
+    // ever allocates. It is index_xor_list over inline slots: links are XOR'd
+    // 1-based slot indices stored in 16 bits when N allows it, every member
+    // is constexpr, and try_* members report a full list by returning false
+    // instead of throwing.
+    template <typename T, std::size_t N>
+    class static_xor_list : public index_xor_list<T, inline_xor_slots<T, N>>
+    {
+        static_assert(N > 0 && N < UINT32_MAX, "static_xor_list capacity must fit a 32-bit slot index");
+        using base = index_xor_list<T, inline_xor_slots<T, N>>;
+
+    public:
+        using typename base::size_type;
+
+    public:
+        using base::base;
+
+    public:
+        constexpr bool full() const;
+        static constexpr size_type capacity();
+    };
+}
+#include "static_xor_list.hpp"
+#endif
@@ -0,0 +1,19 @@
+#ifndef XOR_STATIC_XOR_LIST_HPP
+#define XOR_STATIC_XOR_LIST_HPP
+#include "static_xor_list.h"
+
+namespace my_std
+{
+    template <typename T, std::size_t N>
+    constexpr bool static_xor_list<T, N>::full() const
+    {
+        return this->size() == N;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr typename static_xor_list<T, N>::size_type static_xor_list<T, N>::capacity()
+    {
+        return N;
+    }
+}
+#endif
@@ -0,0 +1,171 @@
+#include "concurrent_xor_list.h"
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace my_std;
+
+// Single-threaded edits at both ends match std::deque, and a reader sees
+// the list as it is when the reader is created.
+static void matches_deque()
+{
+    concurrent_xor_list<long> list;
+    std::deque<long> expected;
+    std::mt19937 rng(1);
+    long next = 0;
+    for (int i = 0; i < 50000; ++i)
+    {
+        long out = 0;
+        switch (rng() % 4)
+        {
+        case 0:
+        case 1:
+            list.push_back(next);
+            expected.push_back(next++);
+            break;
+        case 2:
+            assert(list.try_pop_front(out) == !expected.empty());
+            if (!expected.empty())
+            {
+                assert(out == expected.front());
+                expected.pop_front();
+            }
+            break;
+        case 3:
+            assert(list.try_pop_back(out) == !expected.empty());
+            if (!expected.empty())
+            {
+                assert(out == expected.back());
+                expected.pop_back();
+            }
+            break;
+        }
+        if (i % 1000 == 0)
+        {
+            auto reader = list.read();
+            std::deque<long> seen(reader.begin(), reader.end());
+            assert(seen == expected && list.size() == expected.size());
+        }
+    }
+    list.clear();
+    list.reclaim();
+    assert(list.empty() && list.pending_reclaim() == 0);
+}
+
+// Readers walk while the writer pushes and pops at both ends; every walk
+// must see strictly increasing values and never touch a freed node.
+static void readers_during_writes()
+{
+    concurrent_xor_list<long> list;
+    std::atomic<bool> done{false};
+    std::atomic<long> walks{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&list, &done, &walks]
+                             {
+                                 while (!done.load())
+                                 {
+                                     auto reader = list.read();
+                                     long last = -1;
+                                     for (long value : reader)
+                                     {
+                                         assert(value > last);
+                                         last = value;
+                                     }
+                                     ++walks;
+                                 } });
+    }
+
+    std::mt19937 rng(2);
+    long next = 0;
+    for (int i = 0; i < 300000; ++i)
+    {
+        unsigned op = rng() % 8;
+        if (op < 4 || list.size() < 8)
+        {
+            list.push_back(next++);
+        }
+        else if (op < 6)
+        {
+            list.pop_front();
+        }
+        else
+        {
+            list.pop_back();
+        }
+        while (list.size() > 2000)
+        {
+            list.pop_front();
+        }
+    }
+    done = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    assert(walks > 0);
+}
+
+// A live reader holds back everything retired after it was created; once
+// it is gone the very next retire frees the backlog.
+static void pinned_reader_holds_nodes()
+{
+    concurrent_xor_list<int> list;
+    for (int i = 0; i < 1000; ++i)
+    {
+        list.push_back(i);
+    }
+    {
+        auto reader = list.read();
+        for (int i = 0; i < 500; ++i)
+        {
+            list.pop_front();
+        }
+        assert(list.pending_reclaim() == 500);
+        assert(*reader.begin() == 0);
+    }
+    list.pop_front();
+    assert(list.pending_reclaim() == 0);
+}
+
+// read() fails instead of spinning once every reader slot is taken.
+static void reader_limit()
+{
+    concurrent_xor_list<int> list;
+    list.push_back(1);
+    std::vector<concurrent_xor_list<int>::reader> readers;
+    for (std::size_t i = 0; i < concurrent_xor_list<int>::max_readers; ++i)
+    {
+        readers.push_back(list.read());
+    }
+
+    bool threw = false;
+    try
+    {
+        list.read();
+    }
+    catch (const std::logic_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    readers.pop_back();
+    auto reader = list.read();
+    assert(*reader.begin() == 1);
+}
+
+int main()
+{
+    matches_deque();
+    readers_during_writes();
+    pinned_reader_holds_nodes();
+    reader_limit();
+    std::puts("concurrent_xor_list: ok");
+}
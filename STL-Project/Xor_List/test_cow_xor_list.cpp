@@ -0,0 +1,151 @@
+#include "cow_xor_list.h"
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace my_std;
+
+// Copies share one list and bump its count; dropping them gives it back.
+static void copies_share()
+{
+    cow_xor_list<int> empty;
+    assert(empty.use_count() == 0 && empty.empty());
+    cow_xor_list<int> still_empty = empty;
+    assert(still_empty.use_count() == 0);
+
+    cow_xor_list<int> list = {1, 2, 3};
+    assert(list.use_count() == 1);
+    {
+        cow_xor_list<int> copy = list;
+        cow_xor_list<int> another;
+        another = copy;
+        assert(list.use_count() == 3 && &copy.front() == &list.front());
+        assert(copy == list && another == list);
+    }
+    assert(list.use_count() == 1);
+
+    cow_xor_list<int> moved = std::move(list);
+    assert(moved.use_count() == 1 && list.use_count() == 0 && list.empty());
+    list = std::move(moved);
+    assert(list.use_count() == 1 && (list == cow_xor_list<int>{1, 2, 3}));
+    list = list;
+    assert(list.use_count() == 1);
+}
+
+// The first write through a shared copy clones the chain for that copy
+// only; a sole owner writes in place.
+static void writes_clone_shared_lists()
+{
+    cow_xor_list<int> list = {1, 2, 3};
+    const int *original = &list.front();
+
+    list.push_back(4);
+    assert(&list.front() == original && list.use_count() == 1);
+
+    cow_xor_list<int> copy = list;
+    copy.push_front(0);
+    assert(list.use_count() == 1 && copy.use_count() == 1);
+    assert(&list.front() == original && &*++copy.begin() != original);
+    assert((list == cow_xor_list<int>{1, 2, 3, 4}));
+    assert((copy == cow_xor_list<int>{0, 1, 2, 3, 4}));
+
+    // modify() hands out the list only for the call, and returns what the
+    // callback returns, references included.
+    cow_xor_list<int> shared = list;
+    int &last = shared.modify([](xor_list<int> &inner) -> int &
+                              { return inner.back(); });
+    last = 40;
+    assert(shared.back() == 40 && list.back() == 4 && list.use_count() == 1);
+    std::size_t size = shared.modify([](xor_list<int> &inner)
+                                     {
+                                         inner.reverse();
+                                         return inner.size(); });
+    assert(size == 4 && shared.front() == 40 && list.front() == 1);
+
+    cow_xor_list<int> from_empty;
+    from_empty.modify([](xor_list<int> &inner)
+                      { inner.push_back(7); });
+    assert(from_empty.use_count() == 1 && from_empty.front() == 7);
+}
+
+// clear() on a shared list only lets go of it; on a sole owner it empties
+// the list in place. Popping an empty list throws before cloning anything.
+static void clear_and_pop()
+{
+    cow_xor_list<int> list = {1, 2};
+    cow_xor_list<int> copy = list;
+    copy.clear();
+    assert(copy.use_count() == 0 && copy.empty());
+    assert(list.use_count() == 1 && list.size() == 2);
+
+    list.clear();
+    assert(list.use_count() == 1 && list.empty());
+
+    bool threw = false;
+    try
+    {
+        copy.pop_back();
+    }
+    catch (const std::logic_error &)
+    {
+        threw = true;
+    }
+    assert(threw && copy.use_count() == 0);
+
+    cow_xor_list<int> one = {5};
+    cow_xor_list<int> other = one;
+    other.pop_front();
+    assert(other.empty() && one.size() == 1 && one.use_count() == 1);
+
+    cow_xor_list<int> single = {9};
+    cow_xor_list<int> alias = single;
+    alias.reverse();
+    assert(single.use_count() == 2);
+}
+
+// Threads copy a shared list, read it, then write their own copies; the
+// original is never touched and its count returns to one.
+static void threads_write_their_own_copies()
+{
+    cow_xor_list<int> base;
+    for (int i = 0; i < 1000; ++i)
+    {
+        base.push_back(i);
+    }
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t)
+    {
+        workers.emplace_back([&base, t]
+                             {
+                                 for (int round = 0; round < 50; ++round)
+                                 {
+                                     cow_xor_list<int> copy = base;
+                                     long sum = 0;
+                                     for (int elem : copy)
+                                     {
+                                         sum += elem;
+                                     }
+                                     assert(sum == 999 * 1000 / 2);
+                                     copy.push_back(t);
+                                     copy.pop_front();
+                                     assert(copy.front() == 1 && copy.back() == t && copy.use_count() == 1);
+                                 } });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    assert(base.use_count() == 1 && base.size() == 1000 && base.front() == 0);
+}
+
+int main()
+{
+    copies_share();
+    writes_clone_shared_lists();
+    clear_and_pop();
+    threads_write_their_own_copies();
+    std::puts("cow_xor_list: ok");
+}
@@ -0,0 +1,164 @@
+#include "huge_page_arena.h"
+#include "xor_list.h"
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace my_std;
+
+using arena_list = xor_list<int, huge_page_allocator<int>>;
+
+static bool aligned_to(const void *ptr, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+// Regions are huge-page aligned and a multiple of the huge page size;
+// freed blocks are reused per size class before the cursor moves on.
+static void blocks_and_regions()
+{
+    huge_page_arena::options opts;
+    opts.region_size = 1;
+    opts.prefault = true;
+    huge_page_arena arena(opts);
+    assert(arena.reserved() == 0);
+
+    void *first = arena.allocate(24);
+    assert(aligned_to(first, huge_page_arena::huge_page_size));
+    assert(arena.reserved() == huge_page_arena::huge_page_size);
+
+    void *second = arena.allocate(24);
+    void *other = arena.allocate(100);
+    assert(second != first && aligned_to(second, alignof(std::max_align_t)));
+    assert(aligned_to(other, alignof(std::max_align_t)));
+
+    arena.deallocate(first, 24);
+    assert(arena.allocate(17) == first);
+    arena.deallocate(other, 100);
+    assert(arena.allocate(24) != other);
+    assert(arena.allocate(100) == other);
+    arena.deallocate(nullptr, 24);
+
+    // A request larger than a region gets a region of its own.
+    void *big = arena.allocate(3 * huge_page_arena::huge_page_size);
+    assert(aligned_to(big, huge_page_arena::huge_page_size));
+    assert(arena.reserved() == 4 * huge_page_arena::huge_page_size);
+}
+
+// Without reserved huge pages the MAP_HUGETLB attempt falls back to
+// normal pages; either way the arena works.
+static void hugetlb_falls_back()
+{
+    huge_page_arena::options opts;
+    opts.region_size = huge_page_arena::huge_page_size;
+    opts.use_hugetlb = true;
+    huge_page_arena arena(opts);
+
+    arena_list list(huge_page_allocator<int>{arena});
+    for (int i = 0; i < 1000; ++i)
+    {
+        list.push_back(i);
+    }
+    assert(list.size() == 1000 && list.back() == 999);
+    assert(arena.reserved() == huge_page_arena::huge_page_size);
+    assert(arena.hugetlb_regions() <= 1);
+}
+
+// A list's nodes come from its arena, and nodes it frees are handed out
+// again instead of growing the arena.
+static void lists_reuse_nodes()
+{
+    huge_page_arena::options opts;
+    opts.region_size = huge_page_arena::huge_page_size;
+    huge_page_arena arena(opts);
+    huge_page_allocator<int> aloc(arena);
+
+    arena_list list(aloc);
+    for (int i = 0; i < 50000; ++i)
+    {
+        list.push_back(i);
+    }
+    std::size_t reserved = arena.reserved();
+    assert(reserved >= 50000 * sizeof(int) && reserved % huge_page_arena::huge_page_size == 0);
+
+    list.clear();
+    for (int round = 0; round < 3; ++round)
+    {
+        for (int i = 0; i < 50000; ++i)
+        {
+            list.push_front(i);
+        }
+        list.clear();
+    }
+    assert(arena.reserved() == reserved);
+
+    arena_list copy = {1, 2, 3};
+    assert(copy.get_allocator() == huge_page_allocator<int>());
+    assert(&copy.get_allocator().arena() == &huge_page_arena::global());
+    assert(!(copy.get_allocator() == aloc));
+    assert(huge_page_allocator<double>(aloc) == aloc);
+}
+
+template <typename Fn>
+static bool throws_logic_error(Fn fn)
+{
+    try
+    {
+        fn();
+    }
+    catch (const std::logic_error &)
+    {
+        return true;
+    }
+    return false;
+}
+
+// Every relinking operation refuses lists on different arenas and leaves
+// both lists as they were.
+static void unequal_allocators_throw()
+{
+    huge_page_arena first, second;
+    arena_list lhv({1, 3, 5}, huge_page_allocator<int>(first));
+    arena_list rhv({2, 4}, huge_page_allocator<int>(second));
+    const arena_list lhv_before = lhv;
+    const arena_list rhv_before = rhv;
+
+    assert(throws_logic_error([&]
+                              { lhv.splice_back(rhv); }));
+    assert(throws_logic_error([&]
+                              { lhv.merge(rhv); }));
+    assert(throws_logic_error([&]
+                              { lhv.merge(std::move(rhv), std::less<>()); }));
+    assert(throws_logic_error([&]
+                              { lhv.partition_into([](int x)
+                                                   { return x > 2; },
+                                                   rhv); }));
+    std::vector<arena_list *> lists = {&lhv, &rhv};
+    assert(throws_logic_error([&]
+                              { merge_k(std::span<arena_list *>(lists)); }));
+    assert(lhv == lhv_before && rhv == rhv_before);
+
+    // Lists on the same arena relink as usual.
+    arena_list same({0, 6}, huge_page_allocator<int>(first));
+    lhv.merge(same);
+    assert((lhv == arena_list{0, 1, 3, 5, 6}) && same.empty());
+    assert(lhv.partition_into([](int x)
+                              { return x > 2; },
+                              same) == 3);
+    assert((same == arena_list{3, 5, 6}));
+    lhv.splice_back(same);
+    assert((lhv == arena_list{0, 1, 3, 5, 6}));
+}
+
+int main()
+{
+    blocks_and_regions();
+    hugetlb_falls_back();
+    lists_reuse_nodes();
+    unequal_allocators_throw();
+    std::puts("huge_page_arena: ok");
+}
@@ -0,0 +1,136 @@
+#include "intrusive_xor_list.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace my_std;
+
+struct job
+{
+    int priority = 0;
+    int id = 0;
+    xor_hook by_priority;
+    xor_hook by_arrival;
+
+    bool operator<(const job &rhv) const
+    {
+        return priority < rhv.priority;
+    }
+};
+
+using priority_list = intrusive_xor_list<job, &job::by_priority>;
+using arrival_list = intrusive_xor_list<job, &job::by_arrival>;
+
+static std::vector<int> ids(const priority_list &list)
+{
+    std::vector<int> result;
+    for (const job &j : list)
+    {
+        result.push_back(j.id);
+    }
+    return result;
+}
+
+// One object sits in two lists at once through two hooks; sort is stable
+// and merge keeps both sides' order.
+static void two_hooks_sort_and_merge()
+{
+    std::vector<job> jobs(200);
+    std::mt19937 rng(7);
+    for (int i = 0; i < 200; ++i)
+    {
+        jobs[i].priority = static_cast<int>(rng() % 10);
+        jobs[i].id = i;
+    }
+
+    priority_list ready;
+    arrival_list arrivals;
+    for (job &j : jobs)
+    {
+        ready.push_back(j);
+        arrivals.push_back(j);
+    }
+
+    ready.sort();
+    std::vector<job> expected(jobs.begin(), jobs.end());
+    std::stable_sort(expected.begin(), expected.end());
+    std::vector<int> sorted = ids(ready);
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        assert(sorted[i] == expected[i].id);
+    }
+
+    int id = 0;
+    for (const job &j : arrivals)
+    {
+        assert(j.id == id++);
+    }
+
+    priority_list low;
+    while (ready.front().priority < 5)
+    {
+        job &j = ready.front();
+        ready.pop_front();
+        low.push_back(j);
+    }
+    low.merge(ready);
+    assert(ready.empty() && low.size() == 200 && ids(low) == sorted);
+
+    low.clear();
+    arrivals.clear();
+}
+
+static void erase_and_walk_back()
+{
+    std::vector<job> jobs(10);
+    priority_list list;
+    for (int i = 0; i < 10; ++i)
+    {
+        jobs[i].id = i;
+        list.push_back(jobs[i]);
+    }
+
+    auto it = list.begin();
+    ++it;
+    it = list.erase(it);
+    assert(it->id == 2 && list.size() == 9);
+    assert(jobs[1].by_priority.m_next_prev == nullptr);
+
+    std::vector<int> backwards;
+    for (auto pos = list.end(); pos != list.begin();)
+    {
+        --pos;
+        backwards.push_back(pos->id);
+    }
+    std::reverse(backwards.begin(), backwards.end());
+    assert(backwards == ids(list));
+}
+
+// Destroying or moving from a list leaves no object linked to it.
+static void destructor_unlinks()
+{
+    std::vector<job> jobs(5);
+    {
+        priority_list list;
+        for (job &j : jobs)
+        {
+            list.push_back(j);
+        }
+        priority_list moved(std::move(list));
+        assert(list.empty() && moved.size() == 5);
+    }
+    for (const job &j : jobs)
+    {
+        assert(j.by_priority.m_next_prev == nullptr);
+    }
+}
+
+int main()
+{
+    two_hooks_sort_and_merge();
+    erase_and_walk_back();
+    destructor_unlinks();
+    std::puts("intrusive_xor_list: ok");
+}
@@ -0,0 +1,145 @@
+#include "small_xor_list.h"
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace my_std;
+
+template <typename List>
+static bool stored_inline(const List &list, const typename List::value_type &elem)
+{
+    const char *begin = reinterpret_cast<const char *>(&list);
+    const char *ptr = reinterpret_cast<const char *>(&elem);
+    return ptr >= begin && ptr < begin + sizeof(List);
+}
+
+// The first N nodes sit inside the object, later ones on the heap.
+static void inline_then_heap()
+{
+    small_xor_list<std::string, 4> list;
+    for (int i = 0; i < 6; ++i)
+    {
+        list.push_back(std::to_string(i));
+    }
+
+    int inside = 0;
+    for (const auto &elem : list)
+    {
+        inside += stored_inline(list, elem);
+    }
+    assert(inside == 4);
+    assert(list.size() == 6 && list.front() == "0" && list.back() == "5");
+
+    list.pop_front();
+    list.push_back("6");
+    assert(stored_inline(list, list.back()));
+}
+
+static_assert(std::is_nothrow_move_constructible_v<small_xor_list<std::string, 4>>);
+static_assert(std::is_nothrow_move_assignable_v<small_xor_list<std::unique_ptr<int>, 2>>);
+
+// Moves hand every element over, inline or not, and work for move-only
+// types.
+static void move_only_elements()
+{
+    small_xor_list<std::unique_ptr<int>, 2> source;
+    for (int i = 0; i < 5; ++i)
+    {
+        source.push_back(std::make_unique<int>(i));
+    }
+
+    small_xor_list<std::unique_ptr<int>, 2> target(std::move(source));
+    assert(source.empty() && target.size() == 5);
+    int expected = 0;
+    for (const auto &elem : target)
+    {
+        assert(*elem == expected++);
+    }
+
+    small_xor_list<std::unique_ptr<int>, 2> other;
+    other.push_back(std::make_unique<int>(42));
+    other = std::move(target);
+    assert(target.empty() && other.size() == 5 && *other.back() == 4);
+}
+
+// A move relinks heap nodes where they are and moves only the inline
+// elements, which land in the target's own buffer.
+static void move_keeps_heap_nodes()
+{
+    small_xor_list<std::string, 3> source;
+    for (int i = 0; i < 8; ++i)
+    {
+        source.push_back(std::string(32, static_cast<char>('a' + i)));
+    }
+    std::vector<const std::string *> before;
+    for (const auto &elem : source)
+    {
+        before.push_back(&elem);
+    }
+
+    small_xor_list<std::string, 3> target(std::move(source));
+    assert(source.empty() && target.size() == 8);
+    std::size_t i = 0, inside = 0;
+    for (const auto &elem : target)
+    {
+        assert(elem == std::string(32, static_cast<char>('a' + i)));
+        assert(!stored_inline(source, elem));
+        if (stored_inline(target, elem))
+        {
+            ++inside;
+        }
+        else
+        {
+            assert(&elem == before[i]);
+        }
+        ++i;
+    }
+    assert(inside == 3);
+    for (auto it = target.rbegin(); it != target.rend(); ++it)
+    {
+        assert(*it == std::string(32, static_cast<char>('a' + --i)));
+    }
+
+    // Both buffers are free again: the source fills its own, and the
+    // target reuses the slots it gives back.
+    source.push_back("x");
+    assert(stored_inline(source, source.back()));
+    small_xor_list<std::string, 3> assigned = {"old", "old"};
+    assigned = std::move(target);
+    assert(target.empty() && assigned.size() == 8 && assigned.back() == std::string(32, 'h'));
+    assigned.pop_front();
+    assigned.push_front("new");
+    assert(stored_inline(assigned, assigned.front()));
+
+    small_xor_list<std::string, 3> empty;
+    small_xor_list<std::string, 3> still_empty(std::move(empty));
+    assert(still_empty.empty());
+    still_empty.push_back("y");
+    assert(still_empty.front() == "y");
+}
+
+static void copies_and_swap()
+{
+    small_xor_list<int, 3> a = {5, 1, 4, 2};
+    small_xor_list<int, 3> b = a;
+    assert(a == b);
+
+    b.sort();
+    assert(b.front() == 1 && b.back() == 5 && !(a == b));
+
+    small_xor_list<int, 3> c = {9};
+    c.swap(a);
+    assert(c.size() == 4 && a.size() == 1 && a.front() == 9);
+}
+
+int main()
+{
+    inline_then_heap();
+    move_only_elements();
+    move_keeps_heap_nodes();
+    copies_and_swap();
+    std::puts("small_xor_list: ok");
+}
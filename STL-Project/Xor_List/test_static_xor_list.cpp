@@ -0,0 +1,138 @@
+#include "static_xor_list.h"
+#include "constexpr_xor_list.h"
+#include <cassert>
+#include <cstdio>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace my_std;
+
+// Free slots keep the union initialized, so a partly filled list can be
+// the value of a constexpr variable, also after slots were released.
+constexpr static_xor_list<int, 8> primes{2, 3, 5, 7};
+static_assert(primes.size() == 4 && primes.front() == 2 && primes.back() == 7);
+
+constexpr static_xor_list<int, 4> recycled = []
+{
+    static_xor_list<int, 4> list{1, 2, 3, 4};
+    list.pop_front();
+    list.erase(++list.begin());
+    list.push_front(0);
+    return list;
+}();
+static_assert(recycled == static_xor_list<int, 4>{0, 2, 4});
+
+static_assert(std::bidirectional_iterator<static_xor_list<int, 4>::iterator>);
+static_assert(std::bidirectional_iterator<static_xor_list<int, 4>::const_iterator>);
+static_assert(sizeof(static_xor_list<char, 100>::index_type) == 2);
+static_assert(sizeof(static_xor_list<char, 70000>::index_type) == 4);
+
+constexpr int full_list_rejects_pushes()
+{
+    static_xor_list<int, 3> list{1, 2};
+    bool pushed = list.try_push_back(3);
+    bool rejected = !list.try_push_front(0);
+    return pushed && rejected && list.full() ? list.back() : -1;
+}
+static_assert(full_list_rejects_pushes() == 3);
+
+// The engine is shared with constexpr_xor_list, which grows on the heap.
+constexpr bool growing_list_at_compile_time()
+{
+    constexpr_xor_list<int> list;
+    for (int i = 0; i < 20; ++i)
+    {
+        list.push_back(i);
+    }
+    constexpr_xor_list<int> moved(std::move(list));
+    return list.empty() && moved.size() == 20 && moved.back() == 19;
+}
+static_assert(growing_list_at_compile_time());
+
+static void move_only_elements()
+{
+    static_xor_list<std::unique_ptr<int>, 4> list;
+    list.push_back(std::make_unique<int>(1));
+    list.emplace_back(new int(2));
+    list.emplace_front(new int(0));
+    assert(*list.front() == 0 && *list.back() == 2);
+
+    static_xor_list<std::unique_ptr<int>, 4> moved(std::move(list));
+    assert(list.empty() && moved.size() == 3);
+    int expected = 0;
+    for (const auto &elem : moved)
+    {
+        assert(*elem == expected++);
+    }
+
+    bool threw = false;
+    try
+    {
+        moved.push_back(std::make_unique<int>(3));
+        moved.push_back(std::make_unique<int>(4));
+    }
+    catch (const std::logic_error &)
+    {
+        threw = true;
+    }
+    assert(threw && moved.full());
+}
+
+// Random edits against std::list, with slots recycled through the free list.
+static void matches_std_list()
+{
+    std::mt19937 rng(3);
+    static_xor_list<std::string, 64> list;
+    std::list<std::string> expected;
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string value = std::to_string(i);
+        std::size_t pos = rng() % (expected.size() + 1);
+        switch (rng() % 4)
+        {
+        case 0:
+            if (list.try_push_back(value))
+            {
+                expected.push_back(value);
+            }
+            break;
+        case 1:
+            if (!list.full())
+            {
+                list.insert(std::next(list.begin(), pos), value);
+                expected.insert(std::next(expected.begin(), pos), value);
+            }
+            break;
+        case 2:
+            if (pos < expected.size())
+            {
+                list.erase(std::next(list.begin(), pos));
+                expected.erase(std::next(expected.begin(), pos));
+            }
+            break;
+        case 3:
+            if (!expected.empty())
+            {
+                list.pop_front();
+                expected.pop_front();
+            }
+            break;
+        }
+        assert(list.size() == expected.size());
+    }
+    assert(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+
+    *list.begin() = "changed";
+    assert(list.front() == "changed");
+}
+
+int main()
+{
+    move_only_elements();
+    matches_std_list();
+    std::puts("static_xor_list: ok");
+}
@@ -0,0 +1,80 @@
+#include "xor_list.h"
+#include "thread_cache_allocator.h"
+#include <cassert>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace my_std;
+
+using cached_list = xor_list<long, thread_cache_allocator<long>>;
+
+// Lists built on one thread and cleared on another must hand every block
+// back, and the counters must balance.
+static void cross_thread_frees()
+{
+    constexpr int threads = 4;
+    std::vector<cached_list> lists(threads);
+    for (int round = 0; round < 5; ++round)
+    {
+        std::vector<std::thread> builders;
+        for (int t = 0; t < threads; ++t)
+        {
+            builders.emplace_back([&lists, t]
+                                  {
+                                      for (long i = 0; i < 10000; ++i)
+                                      {
+                                          lists[t].push_back(i);
+                                      } });
+        }
+        for (auto &builder : builders)
+        {
+            builder.join();
+        }
+
+        std::vector<std::thread> cleaners;
+        for (int t = 0; t < threads; ++t)
+        {
+            cleaners.emplace_back([&lists, t]
+                                  { lists[(t + 1) % threads].clear(); });
+        }
+        for (auto &cleaner : cleaners)
+        {
+            cleaner.join();
+        }
+    }
+
+    thread_cache_stats stats = thread_cache_allocator<long>::stats();
+    assert(stats.allocations == stats.deallocations);
+    assert(stats.remote_frees > 0);
+}
+
+// A thread_local list is destroyed after the thread's cache has been
+// parked. Its nodes must flow back for the next thread instead of pinning
+// a fresh cache, so short-lived threads keep reusing the same chunk.
+static void thread_local_lists()
+{
+    std::size_t chunks_before = thread_cache_allocator<long>::stats().chunks;
+    for (int t = 0; t < 200; ++t)
+    {
+        std::thread([]
+                    {
+                        thread_local cached_list list;
+                        for (long i = 0; i < 100; ++i)
+                        {
+                            list.push_back(i);
+                        } })
+            .join();
+    }
+
+    thread_cache_stats stats = thread_cache_allocator<long>::stats();
+    assert(stats.chunks - chunks_before <= 1);
+    assert(stats.allocations == stats.deallocations);
+}
+
+int main()
+{
+    thread_local_lists();
+    cross_thread_frees();
+    std::puts("thread_cache_allocator: ok");
+}
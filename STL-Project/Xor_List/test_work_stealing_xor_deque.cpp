@@ -0,0 +1,146 @@
+#include "work_stealing_xor_deque.h"
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace my_std;
+
+// The owner pops newest first; a thief's request makes the owner publish
+// the older half, which thieves then take oldest first.
+static void owner_and_thief_order()
+{
+    work_stealing_xor_deque<int> deque;
+    for (int i = 0; i < 8; ++i)
+    {
+        deque.push(i);
+    }
+
+    int out = -1;
+    assert(!deque.steal(out));
+    deque.push(8);
+    assert(deque.size() == 9);
+
+    assert(deque.steal(out) && out == 0);
+    xor_list<int> half = deque.steal_half();
+    assert((half == xor_list<int>{1, 2}));
+
+    assert(deque.pop(out) && out == 8);
+    while (deque.pop(out))
+    {
+    }
+    assert(out == 3 && deque.empty());
+}
+
+// An owner that blocks right after pushing does not strand its tasks:
+// they were published either because a thief had asked or because the
+// private list reached publish_threshold.
+static void owner_blocks_after_push()
+{
+    using deque_type = work_stealing_xor_deque<int>;
+    deque_type deque;
+    std::atomic<bool> asked{false};
+    std::promise<int> stolen;
+
+    std::thread thief([&]
+                      {
+                          int task;
+                          if (!deque.steal(task))
+                          {
+                              asked = true;
+                          }
+                          while (!deque.steal(task))
+                          {
+                              std::this_thread::yield();
+                          }
+                          stolen.set_value(task); });
+
+    while (!asked)
+    {
+        std::this_thread::yield();
+    }
+    deque.push(1);
+    // The owner waits on the thief instead of pushing or popping again.
+    assert(stolen.get_future().get() == 1);
+    thief.join();
+
+    deque_type busy;
+    for (int i = 0; i < static_cast<int>(deque_type::publish_threshold); ++i)
+    {
+        busy.push(i);
+    }
+    std::future<xor_list<int>> half = std::async(std::launch::async, [&busy]
+                                                 { return busy.steal_half(); });
+    xor_list<int> taken = half.get();
+    assert(!taken.empty() && taken.front() == 0);
+}
+
+// Tasks pushed by the owner are run exactly once across the owner and
+// several thieves, whichever side picks them up.
+static void each_task_runs_once()
+{
+    constexpr int tasks = 100000;
+    std::unique_ptr<std::atomic<int>[]> runs(new std::atomic<int>[tasks]());
+    std::atomic<int> done{0};
+    auto run = [&runs, &done](int task)
+    {
+        ++runs[task];
+        ++done;
+    };
+
+    work_stealing_xor_deque<int> deque;
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t)
+    {
+        thieves.emplace_back([&deque, &done, &run]
+                             {
+                                 while (done.load() < tasks)
+                                 {
+                                     int task;
+                                     if (deque.steal(task))
+                                     {
+                                         run(task);
+                                         continue;
+                                     }
+                                     for (int stolen : deque.steal_half())
+                                     {
+                                         run(stolen);
+                                     }
+                                 } });
+    }
+
+    for (int i = 0; i < tasks; ++i)
+    {
+        deque.push(i);
+        int task;
+        if (i % 3 == 0 && deque.pop(task))
+        {
+            run(task);
+        }
+    }
+    int task;
+    while (deque.pop(task))
+    {
+        run(task);
+    }
+    for (auto &thief : thieves)
+    {
+        thief.join();
+    }
+
+    for (int i = 0; i < tasks; ++i)
+    {
+        assert(runs[i] == 1);
+    }
+}
+
+int main()
+{
+    owner_and_thief_order();
+    owner_blocks_after_push();
+    each_task_runs_once();
+    std::puts("work_stealing_xor_deque: ok");
+}
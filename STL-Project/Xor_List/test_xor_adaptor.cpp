@@ -0,0 +1,154 @@
+#include "xor_queue.h"
+#include "xor_stack.h"
+#include <cassert>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace my_std;
+
+template <typename T>
+static std::vector<T> contents(const xor_list<T> &list)
+{
+    return std::vector<T>(list.begin(), list.end());
+}
+
+// Single and batched pushes land at the back; pops, pop_front_n and
+// drain_into hand elements out oldest first.
+static void queue_is_fifo()
+{
+    xor_queue<int> queue;
+    assert(queue.empty() && queue.size() == 0);
+    queue.push(1);
+    std::vector<int> more = {2, 3, 4, 5};
+    queue.push_n(more.begin(), 3);
+    xor_list<int> batch = {6, 7};
+    queue.push_list(batch);
+    assert(batch.empty() && queue.size() == 6);
+    assert(queue.front() == 1 && queue.back() == 7);
+
+    queue.pop();
+    int out = 0;
+    assert(queue.try_pop(out) && out == 2 && queue.front() == 3);
+    xor_list<int> taken = queue.pop_front_n(2);
+    assert((contents(taken) == std::vector<int>{3, 4}) && queue.front() == 6);
+    assert(queue.pop_front_n(10).size() == 2 && queue.empty());
+    assert(!queue.try_pop(out) && out == 2);
+
+    xor_queue<std::string> words(xor_list<std::string>{"a", "b", "c"});
+    std::vector<std::string> drained;
+    words.drain_into(std::back_inserter(drained));
+    assert((drained == std::vector<std::string>{"a", "b", "c"}) && words.empty());
+
+    const xor_queue<int> fixed(xor_list<int>{8, 9});
+    assert(fixed.front() == 8 && fixed.back() == 9 && fixed.size() == 2);
+}
+
+// The same batches come out newest first: pop_n and drain_into return
+// elements in the order repeated pops would.
+static void stack_is_lifo()
+{
+    xor_stack<int> stack;
+    stack.push(1);
+    std::vector<int> more = {2, 3, 4};
+    stack.push_n(more.begin(), more.size());
+    xor_list<int> batch = {5, 6, 7};
+    stack.push_list(batch);
+    assert(batch.empty() && stack.size() == 7 && stack.top() == 7);
+
+    stack.pop();
+    int out = 0;
+    assert(stack.try_pop(out) && out == 6 && stack.top() == 5);
+    xor_list<int> taken = stack.pop_n(2);
+    assert((contents(taken) == std::vector<int>{5, 4}) && stack.top() == 3);
+
+    std::vector<int> drained;
+    stack.drain_into(std::back_inserter(drained));
+    assert((drained == std::vector<int>{3, 2, 1}) && stack.empty());
+    assert(!stack.try_pop(out) && stack.pop_n(3).empty());
+
+    const xor_stack<int> fixed(xor_list<int>{8, 9});
+    assert(fixed.top() == 9 && fixed.size() == 2);
+}
+
+// Batches agree with single pops on random traffic, and popping an empty
+// adaptor throws like the list does.
+static void batches_match_single_pops()
+{
+    std::mt19937 gen(41);
+    xor_queue<int> queue, queue_ref;
+    xor_stack<int> stack, stack_ref;
+    int next = 0;
+    for (int round = 0; round < 2000; ++round)
+    {
+        if (gen() % 3)
+        {
+            queue.push(next);
+            queue_ref.push(next);
+            stack.push(next);
+            stack_ref.push(next);
+            ++next;
+            continue;
+        }
+        std::size_t n = gen() % 5;
+        std::vector<int> from_queue = contents(queue.pop_front_n(n));
+        std::vector<int> from_stack = contents(stack.pop_n(n));
+        for (int elem : from_queue)
+        {
+            assert(queue_ref.front() == elem);
+            queue_ref.pop();
+        }
+        for (int elem : from_stack)
+        {
+            assert(stack_ref.top() == elem);
+            stack_ref.pop();
+        }
+        assert(queue.size() == queue_ref.size() && stack.size() == stack_ref.size());
+    }
+
+    queue.clear();
+    bool threw = false;
+    try
+    {
+        queue.pop();
+    }
+    catch (const std::logic_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+// try_pop moves the element out, so move-only types work.
+static void move_only_elements()
+{
+    xor_queue<std::unique_ptr<int>> queue;
+    xor_list<std::unique_ptr<int>> batch;
+    batch.push_back(std::make_unique<int>(1));
+    batch.push_back(std::make_unique<int>(2));
+    queue.push_list(batch);
+    std::unique_ptr<int> out;
+    assert(queue.try_pop(out) && *out == 1 && *queue.front() == 2);
+
+    xor_stack<std::unique_ptr<int>> stack;
+    xor_list<std::unique_ptr<int>> more;
+    more.push_back(std::make_unique<int>(3));
+    more.push_back(std::make_unique<int>(4));
+    stack.push_list(more);
+    std::vector<std::unique_ptr<int>> drained;
+    stack.drain_into(std::back_inserter(drained));
+    assert(drained.size() == 2 && *drained[0] == 4 && *drained[1] == 3);
+}
+
+int main()
+{
+    queue_is_fifo();
+    stack_is_lifo();
+    batches_match_single_pops();
+    move_only_elements();
+    std::puts("xor_queue and xor_stack: ok");
+}
@@ -0,0 +1,163 @@
+#include "xor_channel.h"
+#include <cassert>
+#include <coroutine>
+#include <cstdio>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace my_std;
+
+// Fire-and-forget coroutine; it runs until its first suspension inline.
+struct task
+{
+    struct promise_type
+    {
+        task get_return_object()
+        {
+            return {};
+        }
+        std::suspend_never initial_suspend()
+        {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+};
+
+static void capacity_and_close()
+{
+    xor_channel<int> channel(4);
+    xor_list<int> batch = {1, 2, 3};
+    assert(channel.try_send(batch) && batch.empty() && channel.size() == 3);
+
+    xor_list<int> overflow = {4, 5};
+    assert(!channel.try_send(overflow) && overflow.size() == 2);
+
+    xor_list<int> received;
+    assert(channel.try_receive(received));
+    assert((received == xor_list<int>{1, 2, 3}) && channel.size() == 0);
+
+    // A batch larger than the capacity still fits into an empty channel.
+    xor_list<int> large = {1, 2, 3, 4, 5, 6};
+    assert(channel.try_send(large) && channel.size() == 6);
+
+    channel.close();
+    assert(channel.receive().size() == 6 && channel.receive().empty());
+    bool threw = false;
+    try
+    {
+        channel.send(7);
+    }
+    catch (const std::logic_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+static void threads_exchange_batches()
+{
+    xor_channel<int> channel(16);
+    long sum = 0;
+    int count = 0;
+    std::thread consumer([&channel, &sum, &count]
+                         {
+                             for (xor_list<int> batch = channel.receive(); !batch.empty(); batch = channel.receive())
+                             {
+                                 for (int value : batch)
+                                 {
+                                     sum += value;
+                                     ++count;
+                                 }
+                             } });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; ++p)
+    {
+        producers.emplace_back([&channel]
+                               {
+                                   for (int i = 0; i < 5000; ++i)
+                                   {
+                                       xor_list<int> batch = {1, 2, 3};
+                                       channel.send(batch);
+                                   } });
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    channel.close();
+    consumer.join();
+    assert(count == 60000 && sum == 120000);
+}
+
+static long received_sum = 0;
+static int received_count = 0;
+
+static task consume(xor_channel<int> &channel)
+{
+    for (;;)
+    {
+        xor_list<int> batch = co_await channel.async_receive();
+        if (batch.empty())
+        {
+            co_return;
+        }
+        for (int value : batch)
+        {
+            received_sum += value;
+            ++received_count;
+        }
+    }
+}
+
+static task produce(xor_channel<int> &channel, int base)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        xor_list<int> batch;
+        for (int j = 0; j < 5; ++j)
+        {
+            batch.push_back(base + i * 5 + j);
+        }
+        co_await channel.async_send(std::move(batch));
+    }
+}
+
+// Suspended senders are admitted in order as the consumer drains, and
+// close() wakes the waiting consumer with an empty batch.
+static void coroutines_hand_off()
+{
+    xor_channel<int> channel(8);
+    consume(channel);
+    produce(channel, 0);
+    std::thread other([&channel]
+                      { produce(channel, 1000); });
+    other.join();
+    channel.close();
+
+    long expected = 0;
+    for (int i = 0; i < 500; ++i)
+    {
+        expected += i + 1000 + i;
+    }
+    assert(received_count == 1000 && received_sum == expected);
+}
+
+int main()
+{
+    capacity_and_close();
+    threads_exchange_batches();
+    coroutines_hand_off();
+    std::puts("xor_channel: ok");
+}
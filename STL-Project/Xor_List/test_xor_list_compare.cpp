@@ -0,0 +1,140 @@
+#include "xor_list.h"
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace my_std;
+
+// Equality only: a list of these stores and compares for equality but
+// has no ordering.
+struct unordered_point
+{
+    int x;
+    bool operator==(const unordered_point &) const = default;
+};
+
+static_assert(std::totally_ordered<xor_list<int>>);
+static_assert(std::same_as<decltype(xor_list<int>() <=> xor_list<int>()), std::strong_ordering>);
+static_assert(std::same_as<decltype(xor_list<double>() <=> xor_list<double>()), std::partial_ordering>);
+static_assert(std::same_as<decltype(xor_list<std::string>() <=> xor_list<std::string>()), std::strong_ordering>);
+static_assert(std::equality_comparable<xor_list<unordered_point>>);
+static_assert(!std::three_way_comparable<xor_list<unordered_point>>);
+
+// Tombstones are invisible to ==, as are how the lists were built.
+static void equality()
+{
+    xor_list<int> list = {1, 2, 3};
+    assert(list == list);
+    assert((list == xor_list<int>{1, 2, 3}));
+    assert((list != xor_list<int>{1, 2}));
+    assert((list != xor_list<int>{1, 2, 4}));
+    assert((xor_list<int>() == xor_list<int>()));
+
+    xor_list<int> marked = {1, 9, 2, 9, 3};
+    marked.mark_erased(std::next(marked.begin()));
+    marked.mark_erased(std::next(marked.begin(), 2));
+    assert(marked == list && list == marked);
+    marked.mark_erased(std::next(marked.begin()));
+    assert((marked == xor_list<int>{1, 3}));
+
+    xor_list<unordered_point> points = {{1}, {2}};
+    assert((points == xor_list<unordered_point>{{1}, {2}}));
+    assert((points != xor_list<unordered_point>{{2}, {1}}));
+}
+
+// <=> orders lists like std::vector does, lexicographically with a
+// shorter prefix first.
+static void ordering_matches_vector()
+{
+    std::mt19937 gen(38);
+    for (int round = 0; round < 2000; ++round)
+    {
+        std::vector<int> lhv(gen() % 5), rhv(gen() % 5);
+        for (int &elem : lhv)
+        {
+            elem = static_cast<int>(gen() % 3);
+        }
+        for (int &elem : rhv)
+        {
+            elem = static_cast<int>(gen() % 3);
+        }
+        xor_list<int> lhs(lhv.begin(), lhv.end());
+        xor_list<int> rhs(rhv.begin(), rhv.end());
+        assert((lhs <=> rhs) == (lhv <=> rhv));
+        assert((lhs < rhs) == (lhv < rhv) && (lhs >= rhs) == (lhv >= rhv));
+        assert((lhs == rhs) == (lhv == rhv));
+    }
+
+    xor_list<int> marked = {1, 0, 5};
+    marked.mark_erased(std::next(marked.begin()));
+    assert((marked > xor_list<int>{1, 4}) && (marked < xor_list<int>{1, 5, 0}));
+
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    xor_list<double> with_nan = {1.0, nan};
+    assert(((with_nan <=> xor_list<double>{1.0, 2.0}) == std::partial_ordering::unordered));
+    assert(((with_nan <=> xor_list<double>{0.5, nan}) == std::partial_ordering::greater));
+}
+
+// Equal lists hash alike whatever tombstones they carry, and lists work
+// as keys of ordered and unordered containers.
+static void hashing_and_keys()
+{
+    std::hash<xor_list<int>> hasher;
+    xor_list<int> list = {4, 5, 6};
+    xor_list<int> marked = {4, 0, 5, 6};
+    marked.mark_erased(std::next(marked.begin()));
+    assert(hasher(list) == hasher(marked));
+    assert(hasher(list) != hasher(xor_list<int>{6, 5, 4}));
+    assert(hasher(xor_list<int>()) != hasher(xor_list<int>{0}));
+
+    std::unordered_set<xor_list<int>> seen;
+    std::set<xor_list<int>> sorted;
+    std::mt19937 gen(380);
+    std::set<std::vector<int>> expected;
+    for (int round = 0; round < 500; ++round)
+    {
+        std::vector<int> values(gen() % 4);
+        for (int &elem : values)
+        {
+            elem = static_cast<int>(gen() % 4);
+        }
+        xor_list<int> key(values.begin(), values.end());
+        seen.insert(key);
+        sorted.insert(key);
+        expected.insert(values);
+    }
+    assert(seen.size() == expected.size() && sorted.size() == expected.size());
+    auto want = expected.begin();
+    for (const auto &key : sorted)
+    {
+        assert(std::equal(key.begin(), key.end(), want->begin(), want->end()));
+        assert(seen.count(key) == 1);
+        ++want;
+    }
+
+    std::map<xor_list<std::string>, int> by_words;
+    by_words[{"b"}] = 2;
+    by_words[{"a", "z"}] = 1;
+    by_words[{"a"}] = 0;
+    int expected_value = 0;
+    for (const auto &[words, value] : by_words)
+    {
+        assert(value == expected_value++);
+    }
+}
+
+int main()
+{
+    equality();
+    ordering_matches_vector();
+    hashing_and_keys();
+    std::puts("xor_list compare: ok");
+}
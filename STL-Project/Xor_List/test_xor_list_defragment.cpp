@@ -0,0 +1,128 @@
+#include "xor_list.h"
+#include <cassert>
+#include <cstdio>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace my_std;
+
+static std::ptrdiff_t gap(const int &lhv, const int &rhv)
+{
+    return reinterpret_cast<const char *>(&rhv) - reinterpret_cast<const char *>(&lhv);
+}
+
+// Packed nodes sit next to each other in list order, and the list keeps
+// working on them: erase, push, copy and clear give nodes back per chunk.
+static void packs_in_order()
+{
+    xor_list<int> list;
+    for (int i = 0; i < 5000; ++i)
+    {
+        i % 2 ? list.push_back(i) : list.push_front(i);
+    }
+    for (auto it = std::next(list.begin()); it != list.end() && std::next(it) != list.end(); std::advance(it, 2))
+    {
+        it = list.mark_erased(it);
+    }
+    std::vector<int> before(list.begin(), list.end());
+
+    list.defragment();
+    assert(std::vector<int>(list.begin(), list.end()) == before && list.size() == before.size());
+
+    std::ptrdiff_t stride = gap(*list.begin(), *std::next(list.begin()));
+    assert(stride > 0);
+    std::size_t adjacent = 0;
+    for (auto it = list.begin(); std::next(it) != list.end(); ++it)
+    {
+        adjacent += gap(*it, *std::next(it)) == stride;
+    }
+    // Only chunk boundaries break the run, and even the smallest chunk
+    // holds 255 int nodes.
+    assert(list.size() - 1 - adjacent <= list.size() / 255);
+
+    list.erase(std::next(list.begin(), 10));
+    list.pop_front();
+    list.push_back(-1);
+    xor_list<int> copy = list;
+    assert(copy == list);
+    list.clear();
+    assert(list.empty() && copy.back() == -1);
+
+    xor_list<std::string> words = {"alpha", "beta", "gamma"};
+    words.defragment();
+    words.push_front("zeta");
+    assert((words == xor_list<std::string>{"zeta", "alpha", "beta", "gamma"}));
+}
+
+// A budgeted pass stops after budget nodes, tombstones included, and
+// returns where the next pass picks up.
+static void resumes_by_budget()
+{
+    xor_list<int> list;
+    for (int i = 0; i < 1000; ++i)
+    {
+        list.push_back(i);
+    }
+    list.mark_erased(std::next(list.begin(), 50));
+
+    auto it = list.defragment(list.begin(), 100);
+    assert(*it == 100 && list.size() == 999);
+    int passes = 1;
+    while (it != list.end())
+    {
+        it = list.defragment(it, 100);
+        ++passes;
+    }
+    assert(passes == 10);
+
+    std::vector<int> expected(1000);
+    std::iota(expected.begin(), expected.end(), 0);
+    expected.erase(expected.begin() + 50);
+    assert(std::vector<int>(list.begin(), list.end()) == expected);
+    assert(list.defragment(list.begin(), 0) == list.begin());
+}
+
+// Chunks are sized by the nodes left in the pass, not by the whole list:
+// 300 nodes at the end of a long list fill one 255-node chunk and start a
+// second, where sizing by the list would put them all in one large chunk.
+static void sizes_chunks_by_remaining_nodes()
+{
+    constexpr int total = 20000;
+    constexpr int tail = 300;
+    xor_list<int> list;
+    for (int i = 0; i < total; ++i)
+    {
+        list.push_back(i);
+    }
+
+    auto from = std::next(list.begin(), total - tail);
+    list.defragment(from, total);
+    std::vector<const int *> moved;
+    for (auto it = std::next(list.begin(), total - tail); it != list.end(); ++it)
+    {
+        moved.push_back(&*it);
+    }
+    assert(moved.size() == tail && *moved.front() == total - tail);
+
+    std::ptrdiff_t stride = gap(*moved[0], *moved[1]);
+    std::size_t first_chunk = 1;
+    while (first_chunk < moved.size() && gap(*moved[first_chunk - 1], *moved[first_chunk]) == stride)
+    {
+        ++first_chunk;
+    }
+    assert(first_chunk < moved.size() && first_chunk * stride < 4096);
+    for (std::size_t i = first_chunk + 1; i < moved.size(); ++i)
+    {
+        assert(gap(*moved[i - 1], *moved[i]) == stride);
+    }
+}
+
+int main()
+{
+    packs_in_order();
+    resumes_by_budget();
+    sizes_chunks_by_remaining_nodes();
+    std::puts("xor_list defragment: ok");
+}
@@ -0,0 +1,286 @@
+#include "xor_list.h"
+#include <cassert>
+#include <cstdio>
+#include <iterator>
+#include <list>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace my_std;
+
+using list_type = xor_list<int>;
+
+// Every iterator models std::bidirectional_iterator for any element type,
+// and the list is a bidirectional, sized, common range.
+template <typename T>
+constexpr bool models_bidirectional()
+{
+    using list = xor_list<T>;
+    static_assert(std::bidirectional_iterator<typename list::iterator>);
+    static_assert(std::bidirectional_iterator<typename list::const_iterator>);
+    static_assert(std::bidirectional_iterator<typename list::reverse_iterator>);
+    static_assert(std::bidirectional_iterator<typename list::const_reverse_iterator>);
+    static_assert(std::output_iterator<typename list::iterator, T>);
+    static_assert(!std::output_iterator<typename list::const_iterator, T>);
+    static_assert(std::same_as<std::iter_reference_t<typename list::iterator>, T &>);
+    static_assert(std::same_as<std::iter_reference_t<const typename list::iterator>, T &>);
+    static_assert(std::same_as<std::iter_reference_t<typename list::const_iterator>, const T &>);
+    static_assert(std::same_as<std::iter_reference_t<typename list::const_reverse_iterator>, const T &>);
+
+    static_assert(std::ranges::bidirectional_range<list>);
+    static_assert(std::ranges::bidirectional_range<const list>);
+    static_assert(std::ranges::common_range<list>);
+    static_assert(std::ranges::sized_range<list>);
+    static_assert(std::ranges::sized_range<const list>);
+    static_assert(!std::ranges::random_access_range<list>);
+    static_assert(std::ranges::bidirectional_range<decltype(std::declval<list &>().reversed())>);
+    return true;
+}
+static_assert(models_bidirectional<int>());
+static_assert(models_bidirectional<std::string>());
+static_assert(models_bidirectional<std::vector<int>>());
+
+template <typename List, typename It>
+concept erasable_at = requires(List &list, It pos) { list.erase(pos); };
+
+template <typename List, typename It>
+concept insertable_at = requires(List &list, It pos) { list.insert(pos, 0); };
+
+// Reverse iterators do not decay to forward ones, so handing one to erase
+// or insert is a compile error instead of acting on the wrong node.
+static_assert(erasable_at<list_type, list_type::iterator>);
+static_assert(!erasable_at<list_type, list_type::reverse_iterator>);
+static_assert(!erasable_at<list_type, list_type::const_reverse_iterator>);
+static_assert(insertable_at<list_type, list_type::iterator>);
+static_assert(!insertable_at<list_type, list_type::reverse_iterator>);
+static_assert(!std::is_convertible_v<list_type::reverse_iterator, list_type::iterator>);
+static_assert(!std::is_convertible_v<list_type::reverse_iterator, list_type::const_iterator>);
+static_assert(!std::is_convertible_v<list_type::const_reverse_iterator, list_type::const_iterator>);
+static_assert(std::is_convertible_v<list_type::reverse_iterator, list_type::const_reverse_iterator>);
+static_assert(!std::is_convertible_v<list_type::const_reverse_iterator, list_type::reverse_iterator>);
+
+// base() follows std::reverse_iterator: it names the element after the
+// one the reverse iterator points at, skipping tombstones.
+static void reverse_iterator_base()
+{
+    list_type list = {1, 2, 3, 4, 5};
+    assert(list.rbegin().base() == list.end());
+    assert(list.rend().base() == list.begin());
+
+    auto rit = std::next(list.rbegin());
+    assert(*rit == 4 && *rit.base() == 5 && *std::prev(rit.base()) == 4);
+
+    list.mark_erased(std::next(list.begin(), 3));
+    rit = std::next(list.rbegin());
+    assert(*rit == 3 && *rit.base() == 5);
+
+    list_type::const_reverse_iterator crit = rit;
+    assert(*crit == 3 && crit.base() == std::prev(list.cend()));
+    assert(crit == std::next(list.crbegin()));
+
+    // The usual idiom erases the element a reverse iterator points at.
+    list.erase(std::prev(rit.base()));
+    assert((std::vector<int>(list.rbegin(), list.rend()) == std::vector<int>{5, 2, 1}));
+    list.insert(list.rend().base(), 0);
+    assert((std::vector<int>(list.crbegin(), list.crend()) == std::vector<int>{5, 2, 1, 0}));
+
+    std::vector<int> walked;
+    for (int elem : list.reversed())
+    {
+        walked.push_back(elem);
+    }
+    assert((walked == std::vector<int>{5, 2, 1, 0}));
+    assert(*--list.rend() == 0 && *std::prev(list.rend(), 2) == 1);
+
+    list_type empty;
+    assert(empty.rbegin() == empty.rend() && empty.rbegin().base() == empty.end());
+}
+
+// Views compose over the list lazily, including from the back.
+static void runs_under_views()
+{
+    list_type list = {1, 2, 3, 4, 5, 6};
+    auto odd_squares = list | std::views::filter([](int x)
+                                                 { return x % 2; }) |
+                       std::views::transform([](int x)
+                                             { return x * x; }) |
+                       std::views::reverse;
+    assert((std::vector<int>(odd_squares.begin(), odd_squares.end()) == std::vector<int>{25, 9, 1}));
+    assert(std::ranges::size(list) == 6 && *std::ranges::prev(std::ranges::end(list)) == 6);
+
+    list.mark_erased(std::next(list.begin(), 2));
+    auto tail = list | std::views::drop(2);
+    assert(*std::ranges::begin(tail) == 4 && std::ranges::distance(tail) == 3);
+}
+
+// Walking back from the tail must give the same elements, or a relink
+// left a stale neighbour behind.
+static bool matches(const list_type &list, const std::list<int> &expected)
+{
+    return list.size() == expected.size() && std::equal(list.begin(), list.end(), expected.begin(), expected.end()) &&
+           std::equal(list.rbegin(), list.rend(), expected.rbegin(), expected.rend());
+}
+
+// insert and erase at any position, tombstones next to it included, agree
+// with std::list on the contents and on the iterator they return.
+static void inserts_and_erases_anywhere()
+{
+    std::mt19937 gen(46);
+    list_type list;
+    std::list<int> expected;
+    int next = 0;
+    for (int round = 0; round < 5000; ++round)
+    {
+        std::size_t at = gen() % (expected.size() + 1);
+        auto pos = std::next(list.begin(), at);
+        auto want = std::next(expected.begin(), at);
+        list_type::iterator it;
+        std::list<int>::iterator want_it;
+        switch (gen() % 7)
+        {
+        case 0:
+        case 1:
+            it = list.insert(pos, next);
+            want_it = expected.insert(want, next++);
+            break;
+        case 2:
+        {
+            std::size_t count = gen() % 3;
+            it = list.insert(pos, count, next);
+            want_it = expected.insert(want, count, next++);
+            break;
+        }
+        case 3:
+            it = list.insert(pos, {next, next + 1, next + 2});
+            want_it = expected.insert(want, {next, next + 1, next + 2});
+            next += 3;
+            break;
+        case 4:
+        {
+            list_type source = {next, next + 1};
+            it = list.insert(pos, source.begin(), source.end());
+            want_it = expected.insert(want, source.begin(), source.end());
+            next += 2;
+            break;
+        }
+        case 5:
+            if (want == expected.end())
+            {
+                continue;
+            }
+            if (gen() % 2)
+            {
+                it = list.erase(pos);
+                want_it = expected.erase(want);
+            }
+            else
+            {
+                std::size_t count = gen() % (std::distance(want, expected.end()) + 1);
+                it = list.erase(pos, std::next(pos, count));
+                want_it = expected.erase(want, std::next(want, count));
+            }
+            break;
+        default:
+            if (want == expected.end())
+            {
+                continue;
+            }
+            it = list.mark_erased(pos);
+            want_it = expected.erase(want);
+            break;
+        }
+        assert(std::distance(list.begin(), it) == std::distance(expected.begin(), want_it));
+        assert(matches(list, expected));
+    }
+
+    list_type small = {1, 3};
+    assert(*small.insert_def(std::next(small.begin()), 2) == 2);
+    assert(*small.insert_rev(std::next(small.begin(), 2), 4) == 4);
+    assert(matches(small, {1, 2, 3, 4}));
+    bool threw = false;
+    try
+    {
+        small.erase(small.end());
+    }
+    catch (const std::logic_error &)
+    {
+        threw = true;
+    }
+    assert(threw && small.size() == 4);
+}
+
+// A cursor edits where it stands without re-walking the list, skips
+// tombstones both ways, and stays valid across its own erases.
+static void cursor_edits_in_place()
+{
+    list_type list = {1, 2, 3, 4, 5, 6};
+    auto cur = list.begin_cursor();
+    assert(cur.at_begin() && !cur.at_end() && *cur == 1);
+    while (!cur.at_end())
+    {
+        if (*cur % 2 == 0)
+        {
+            cur.erase_current();
+        }
+        else
+        {
+            cur.insert_after(*cur * 10);
+            cur.move_next();
+            cur.move_next();
+        }
+    }
+    assert(matches(list, {1, 10, 3, 30, 5, 50}));
+
+    cur.insert_before(7);
+    assert(cur.at_end() && list.back() == 7);
+    assert(cur.move_prev() && *cur == 7 && cur.position() == std::prev(list.end()));
+    cur.erase_current();
+    assert(cur.at_end() && list.back() == 50);
+    assert(!cur.move_next());
+
+    list.mark_erased(std::next(list.begin(), 3));
+    list.mark_erased(std::next(list.begin(), 3));
+    cur = list.cursor_at(std::next(list.begin(), 3));
+    assert(*cur == 50 && cur.move_prev() && *cur == 3);
+    assert(cur.move_next() && *cur == 50);
+    cur.insert_before(4);
+    assert(matches(list, {1, 10, 3, 4, 50}));
+
+    auto front = list.begin_cursor();
+    front.insert_before(0);
+    assert(!front.at_begin() && *front == 1 && list.front() == 0);
+    assert(front.move_prev() && front.at_begin() && !front.move_prev());
+    front.erase_current();
+    front.erase_current();
+    assert(*front == 10 && front.at_begin() && matches(list, {10, 3, 4, 50}));
+    assert(front.position() == list.begin());
+
+    list_type empty;
+    auto none = empty.end_cursor();
+    assert(none.at_begin() && none.at_end() && !none.move_prev());
+    bool threw = false;
+    try
+    {
+        none.insert_after(1);
+    }
+    catch (const std::logic_error &)
+    {
+        threw = true;
+    }
+    assert(threw && empty.empty());
+    none.insert_before(1);
+    assert(matches(empty, {1}) && none.at_end());
+}
+
+int main()
+{
+    reverse_iterator_base();
+    runs_under_views();
+    inserts_and_erases_anywhere();
+    cursor_edits_in_place();
+    std::puts("xor_list iterators: ok");
+}
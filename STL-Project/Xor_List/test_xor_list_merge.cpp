@@ -0,0 +1,169 @@
+#include "xor_list.h"
+#include "huge_page_arena.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace my_std;
+
+// Sorted by key only; the tag tells equal keys apart.
+using entry = std::pair<int, int>;
+
+struct by_key
+{
+    bool operator()(const entry &lhv, const entry &rhv) const
+    {
+        return lhv.first < rhv.first;
+    }
+};
+
+template <typename List>
+static std::vector<typename List::value_type> contents(const List &list)
+{
+    return std::vector<typename List::value_type>(list.begin(), list.end());
+}
+
+// The old merge stopped advancing after the first node of each list; runs
+// longer than one node on either side must come through whole.
+static void merges_runs()
+{
+    xor_list<int> lhv = {1, 2, 3, 10, 11, 20};
+    xor_list<int> rhv = {0, 4, 5, 6, 12, 21, 22, 23};
+    lhv.merge(rhv);
+    assert(rhv.empty() && lhv.size() == 14);
+    assert((contents(lhv) == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 10, 11, 12, 20, 21, 22, 23}));
+    assert(lhv.front() == 0 && lhv.back() == 23);
+    assert(*std::prev(lhv.end()) == 23 && *std::next(lhv.rbegin()) == 22);
+
+    xor_list<int> empty;
+    lhv.merge(empty);
+    empty.merge(lhv);
+    assert(lhv.empty() && empty.size() == 14);
+    empty.merge(empty);
+    assert(empty.size() == 14);
+
+    // Tombstones on either side are dropped before relinking.
+    xor_list<int> marked = {1, 3, 5, 7};
+    marked.mark_erased(std::next(marked.begin()));
+    empty.merge(xor_list<int>{2, 8});
+    empty.merge(std::move(marked));
+    assert(empty.size() == 19 && std::is_sorted(empty.begin(), empty.end()));
+    assert(std::count(empty.begin(), empty.end(), 3) == 1);
+}
+
+// Equal keys keep *this's elements first and each side's own order, for
+// both the default and a custom ordering.
+static void merge_is_stable()
+{
+    xor_list<entry> lhv = {{1, 0}, {2, 0}, {2, 1}, {4, 0}};
+    xor_list<entry> rhv = {{1, 1}, {2, 2}, {3, 0}, {4, 1}};
+    lhv.merge(rhv, by_key());
+    assert((contents(lhv) == std::vector<entry>{{1, 0}, {1, 1}, {2, 0}, {2, 1}, {2, 2}, {3, 0}, {4, 0}, {4, 1}}));
+
+    xor_list<int> descending = {9, 7, 7, 1};
+    descending.merge(xor_list<int>{8, 7, 0}, std::greater<>());
+    assert((contents(descending) == std::vector<int>{9, 8, 7, 7, 7, 1, 0}));
+}
+
+// merge_k against a stable sort of everything, with empty inputs mixed in.
+static void merge_k_matches_stable_sort()
+{
+    std::mt19937 gen(30);
+    for (int round = 0; round < 50; ++round)
+    {
+        std::vector<xor_list<entry>> lists(1 + gen() % 7);
+        std::vector<entry> expected;
+        for (std::size_t i = 0; i < lists.size(); ++i)
+        {
+            std::vector<int> keys(gen() % 40);
+            for (int &key : keys)
+            {
+                key = static_cast<int>(gen() % 10);
+            }
+            std::sort(keys.begin(), keys.end());
+            for (int key : keys)
+            {
+                lists[i].push_back({key, static_cast<int>(i)});
+                expected.push_back({key, static_cast<int>(i)});
+            }
+        }
+        std::stable_sort(expected.begin(), expected.end(), by_key());
+
+        std::vector<xor_list<entry> *> pointers;
+        for (auto &list : lists)
+        {
+            pointers.push_back(&list);
+        }
+        xor_list<entry> merged = merge_k(std::span<xor_list<entry> *>(pointers), by_key());
+        assert(contents(merged) == expected && merged.size() == expected.size());
+        for (const auto &list : lists)
+        {
+            assert(list.empty());
+        }
+    }
+
+    std::vector<xor_list<int> *> none;
+    assert(merge_k(std::span<xor_list<int> *>(none)).empty());
+
+    xor_list<int> a = {5, 3}, b = {4, 2, 0};
+    std::vector<xor_list<int> *> pair = {&a, &b};
+    xor_list<int> merged = merge_k(std::span<xor_list<int> *>(pair), std::greater<>());
+    assert((contents(merged) == std::vector<int>{5, 4, 3, 2, 0}));
+}
+
+// Relinking between lists whose allocators compare unequal would free
+// nodes through the wrong allocator, so both merges refuse and leave every
+// list as it was.
+static void unequal_allocators_throw()
+{
+    huge_page_arena first, second;
+    using list_type = xor_list<int, huge_page_allocator<int>>;
+    list_type lhv({1, 3}, huge_page_allocator<int>(first));
+    list_type rhv({2, 4}, huge_page_allocator<int>(second));
+
+    bool threw = false;
+    try
+    {
+        lhv.merge(rhv);
+    }
+    catch (const std::logic_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+    assert((contents(lhv) == std::vector<int>{1, 3}) && (contents(rhv) == std::vector<int>{2, 4}));
+
+    list_type same({0, 5}, huge_page_allocator<int>(first));
+    std::vector<list_type *> lists = {&lhv, &same, &rhv};
+    threw = false;
+    try
+    {
+        merge_k(std::span<list_type *>(lists));
+    }
+    catch (const std::logic_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+    assert(lhv.size() == 2 && same.size() == 2 && rhv.size() == 2);
+
+    lists.pop_back();
+    list_type merged = merge_k(std::span<list_type *>(lists));
+    assert((contents(merged) == std::vector<int>{0, 1, 3, 5}));
+    assert(merged.get_allocator() == huge_page_allocator<int>(first));
+}
+
+int main()
+{
+    merges_runs();
+    merge_is_stable();
+    merge_k_matches_stable_sort();
+    unequal_allocators_throw();
+    std::puts("xor_list merge: ok");
+}
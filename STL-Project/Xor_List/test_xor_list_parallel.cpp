@@ -0,0 +1,99 @@
+#include "xor_list_parallel.h"
+#include "thread_cache_allocator.h"
+#include <cassert>
+#include <cstdio>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace my_std;
+
+// Large enough to split into several parts on a multi-core machine.
+static constexpr int elements = 3'000'000;
+
+static void build_copy_and_assign()
+{
+    std::vector<long> source(elements);
+    std::iota(source.begin(), source.end(), 0);
+
+    xor_list<long> built = xor_list_parallel::build(std::execution::par, source.begin(), source.end());
+    assert(built.size() == source.size());
+    assert(std::equal(built.begin(), built.end(), source.begin()));
+
+    // Tombstones in the source are skipped by the copy.
+    for (auto it = std::next(built.begin()); it != built.end() && std::next(it) != built.end();)
+    {
+        it = built.mark_erased(it);
+        ++it;
+    }
+    xor_list<long> copied = xor_list_parallel::copy(std::execution::par, built);
+    assert(copied == built);
+
+    xor_list<long> target = {1, 2, 3};
+    xor_list_parallel::assign(std::execution::par, target, source.begin(), source.begin() + 5);
+    assert((target == xor_list<long>{0, 1, 2, 3, 4}));
+    xor_list_parallel::assign(std::execution::seq, target, copied);
+    assert(target == copied);
+
+    xor_list<long> empty = xor_list_parallel::build(std::execution::par, source.begin(), source.begin());
+    assert(empty.empty());
+
+    auto cached = xor_list_parallel::build(std::execution::par_unseq, source.begin(), source.end(), thread_cache_allocator<long>());
+    assert(cached.size() == source.size() && cached.front() == 0 && cached.back() == elements - 1);
+}
+
+static void search_from_both_ends()
+{
+    std::vector<int> source(elements);
+    std::iota(source.begin(), source.end(), 0);
+    xor_list<int> list(source.begin(), source.end());
+
+    for (int x : {0, 5, elements / 2 - 1, elements / 2, elements - 1})
+    {
+        auto it = xor_list_parallel::find(std::execution::par, list, x);
+        assert(it != list.end() && *it == x);
+        if (x > 0)
+        {
+            assert(*std::prev(it) == x - 1);
+        }
+        assert(xor_list_parallel::count(std::execution::par, list, x) == 1);
+        assert(xor_list_parallel::contains(std::execution::par, list, x));
+    }
+    assert(xor_list_parallel::find(std::execution::par, list, -1) == list.end());
+
+    // find returns the first match even when the back half also has one.
+    list.push_back(7);
+    assert(std::distance(list.begin(), xor_list_parallel::find(std::execution::par, list, 7)) == 7);
+    assert(xor_list_parallel::count(std::execution::par, list, 7) == 2);
+    assert(xor_list_parallel::count(std::execution::seq, list, 7) == 2);
+
+    list.mark_erased(list.find(elements - 10));
+    assert(xor_list_parallel::find(std::execution::par, list, elements - 10) == list.end());
+    assert(!xor_list_parallel::any_of(std::execution::par, list, [](int x)
+                                      { return x < 0; }));
+
+    bool threw = false;
+    try
+    {
+        xor_list_parallel::any_of(std::execution::par, list, [](int x)
+                                  {
+                                      if (x == elements - 100)
+                                      {
+                                          throw std::runtime_error("predicate");
+                                      }
+                                      return false; });
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+int main()
+{
+    build_copy_and_assign();
+    search_from_both_ends();
+    std::puts("xor_list_parallel: ok");
+}
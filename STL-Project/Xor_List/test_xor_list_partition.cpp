@@ -0,0 +1,179 @@
+#include "xor_list.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using namespace my_std;
+
+// Counts copies and moves, which relinking must not make.
+struct counted
+{
+    static inline int transfers = 0;
+
+    int value;
+
+    counted(int v) : value(v) {}
+    counted(const counted &rhv) : value(rhv.value)
+    {
+        ++transfers;
+    }
+    counted(counted &&rhv) noexcept : value(rhv.value)
+    {
+        ++transfers;
+    }
+    counted &operator=(const counted &rhv)
+    {
+        value = rhv.value;
+        ++transfers;
+        return *this;
+    }
+    auto operator<=>(const counted &) const = default;
+};
+
+static std::vector<int> random_values(std::mt19937 &gen, std::size_t max_size, int range)
+{
+    std::vector<int> values(gen() % (max_size + 1));
+    for (int &elem : values)
+    {
+        elem = static_cast<int>(gen() % range);
+    }
+    return values;
+}
+
+static std::vector<int> contents(const xor_list<int> &list)
+{
+    return std::vector<int>(list.begin(), list.end());
+}
+
+// Both partitions are stable and return the first non-matching element;
+// partition_into moves the matching nodes to the back of another list.
+static void partitions_are_stable()
+{
+    std::mt19937 gen(39);
+    auto odd = [](int x)
+    { return x % 2 != 0; };
+    for (int round = 0; round < 300; ++round)
+    {
+        std::vector<int> values = random_values(gen, 60, 100);
+        std::vector<int> expected = values;
+        auto split = std::stable_partition(expected.begin(), expected.end(), odd);
+
+        xor_list<int> list(values.begin(), values.end());
+        auto it = round % 2 ? list.partition(odd) : list.stable_partition(odd);
+        assert(contents(list) == expected);
+        assert(std::distance(list.begin(), it) == split - expected.begin());
+
+        xor_list<int> source(values.begin(), values.end());
+        xor_list<int> out = {-1};
+        std::size_t moved = source.partition_into(odd, out);
+        std::vector<int> kept;
+        std::remove_copy_if(values.begin(), values.end(), std::back_inserter(kept), odd);
+        assert(moved == static_cast<std::size_t>(split - expected.begin()));
+        assert(contents(source) == kept && out.size() == moved + 1 && out.front() == -1);
+        assert(std::equal(std::next(out.begin()), out.end(), expected.begin(), split));
+    }
+
+    xor_list<int> marked = {1, 2, 3, 4};
+    marked.mark_erased(std::next(marked.begin()));
+    assert(*marked.stable_partition(odd) == 4);
+    assert((contents(marked) == std::vector<int>{1, 3, 4}));
+}
+
+// nth_element puts the element a full sort would put at n there, with no
+// greater element before it and no smaller one after it.
+static void nth_element_selects()
+{
+    std::mt19937 gen(390);
+    for (int round = 0; round < 300; ++round)
+    {
+        std::vector<int> values = random_values(gen, 80, round % 3 ? 1000 : 4);
+        if (values.empty())
+        {
+            continue;
+        }
+        std::vector<int> sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+        std::size_t n = gen() % values.size();
+
+        xor_list<int> list(values.begin(), values.end());
+        auto it = list.nth_element(n);
+        assert(*it == sorted[n] && std::distance(list.begin(), it) == static_cast<std::ptrdiff_t>(n));
+        assert(std::all_of(list.begin(), it, [&](int x)
+                           { return x <= *it; }));
+        assert(std::all_of(it, list.end(), [&](int x)
+                           { return x >= *it; }));
+        std::vector<int> after = contents(list);
+        std::sort(after.begin(), after.end());
+        assert(after == sorted);
+
+        xor_list<int> descending(values.begin(), values.end());
+        assert(*descending.nth_element(n, std::greater<>()) == sorted[sorted.size() - 1 - n]);
+    }
+
+    xor_list<int> list = {3, 1, 2};
+    assert(list.nth_element(3) == list.end());
+    xor_list<int> empty;
+    assert(empty.nth_element(0) == empty.end());
+}
+
+// partial_sort leaves the k smallest in order at the front and the rest
+// after them in some order.
+static void partial_sort_orders_prefix()
+{
+    std::mt19937 gen(3900);
+    for (int round = 0; round < 300; ++round)
+    {
+        std::vector<int> values = random_values(gen, 80, round % 2 ? 1000 : 5);
+        std::vector<int> sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+        std::size_t k = gen() % (values.size() + 3);
+
+        xor_list<int> list(values.begin(), values.end());
+        list.partial_sort(k);
+        std::vector<int> after = contents(list);
+        std::size_t prefix = std::min(k, values.size());
+        assert(std::equal(after.begin(), after.begin() + prefix, sorted.begin()));
+        std::sort(after.begin(), after.end());
+        assert(after == sorted && list.size() == values.size());
+
+        xor_list<int> descending(values.begin(), values.end());
+        descending.partial_sort(k, std::greater<>());
+        assert(std::equal(descending.begin(), std::next(descending.begin(), prefix), sorted.rbegin()));
+    }
+}
+
+// None of them copies or moves an element.
+static void only_relinks()
+{
+    xor_list<counted> list;
+    for (int i : {5, 3, 8, 1, 9, 2, 7, 4, 6, 0})
+    {
+        list.push_back(counted(i));
+    }
+    xor_list<counted> out;
+    counted::transfers = 0;
+
+    list.partition([](const counted &c)
+                   { return c.value < 5; });
+    list.nth_element(4);
+    list.partial_sort(6);
+    list.partition_into([](const counted &c)
+                        { return c.value > 6; },
+                        out);
+    assert(counted::transfers == 0);
+    assert(list.size() == 7 && out.size() == 3);
+    assert(list.front().value == 0 && std::next(list.begin(), 5)->value == 5);
+}
+
+int main()
+{
+    partitions_are_stable();
+    nth_element_selects();
+    partial_sort_orders_prefix();
+    only_relinks();
+    std::puts("xor_list partition: ok");
+}
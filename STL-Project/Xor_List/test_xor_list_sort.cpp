@@ -0,0 +1,152 @@
+#include "xor_list.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace my_std;
+
+struct record
+{
+    std::int64_t key;
+    int tag;
+
+    bool operator==(const record &) const = default;
+};
+
+template <typename T>
+static std::vector<T> contents(const xor_list<T> &list)
+{
+    return std::vector<T>(list.begin(), list.end());
+}
+
+// Walking back from the tail must agree, or the relinked chain is broken.
+template <typename T>
+static bool links_agree(const xor_list<T> &list)
+{
+    std::vector<T> backwards(list.rbegin(), list.rend());
+    std::reverse(backwards.begin(), backwards.end());
+    return backwards == contents(list) && backwards.size() == list.size();
+}
+
+template <typename T>
+static void sort_matches_std(std::mt19937_64 &gen, std::vector<T> extremes)
+{
+    for (int round = 0; round < 100; ++round)
+    {
+        std::vector<T> values = extremes;
+        for (std::size_t i = gen() % 200; i > 0; --i)
+        {
+            values.push_back(static_cast<T>(gen()));
+        }
+        std::shuffle(values.begin(), values.end(), gen);
+
+        xor_list<T> list(values.begin(), values.end());
+        list.sort();
+        std::sort(values.begin(), values.end());
+        assert(contents(list) == values && links_agree(list));
+    }
+}
+
+// The radix path handles every integral width, signed keys included.
+static void sorts_integers()
+{
+    std::mt19937_64 gen(40);
+    sort_matches_std<int>(gen, {std::numeric_limits<int>::min(), -1, 0, 1, std::numeric_limits<int>::max()});
+    sort_matches_std<std::int8_t>(gen, {-128, -1, 0, 127});
+    sort_matches_std<std::int64_t>(gen, {std::numeric_limits<std::int64_t>::min(), -1, 0, std::numeric_limits<std::int64_t>::max()});
+    sort_matches_std<unsigned>(gen, {0u, 1u, std::numeric_limits<unsigned>::max()});
+    sort_matches_std<std::uint64_t>(gen, {0, std::numeric_limits<std::uint64_t>::max()});
+    sort_matches_std<char>(gen, {'\0', 'a', '\x7f'});
+    sort_matches_std<bool>(gen, {true, false});
+
+    // Keys that share their high bytes, so those passes are skipped.
+    xor_list<long> close = {1000003, 1000001, 1000002, 1000000, -1000000};
+    close.sort();
+    assert((contents(close) == std::vector<long>{-1000000, 1000000, 1000001, 1000002, 1000003}));
+}
+
+// Empty and one-element lists are left alone, tombstones are dropped,
+// and non-integral types go through the chain merge sort.
+static void small_and_other_lists()
+{
+    xor_list<int> empty;
+    empty.sort();
+    empty.sort_by_key([](int x)
+                      { return -x; });
+    assert(empty.empty());
+
+    xor_list<int> one = {7};
+    one.sort();
+    assert(one.front() == 7 && one.back() == 7 && one.size() == 1);
+
+    xor_list<int> marked = {5, 100, 3, -100, 4};
+    marked.mark_erased(std::next(marked.begin()));
+    marked.mark_erased(std::next(marked.begin(), 2));
+    marked.sort();
+    assert((contents(marked) == std::vector<int>{3, 4, 5}) && links_agree(marked));
+
+    xor_list<std::string> words = {"pear", "apple", "fig", "apple", ""};
+    words.sort();
+    assert((contents(words) == std::vector<std::string>{"", "apple", "apple", "fig", "pear"}));
+    assert(links_agree(words));
+
+    std::mt19937_64 gen(400);
+    std::vector<double> values(5000);
+    for (double &val : values)
+    {
+        val = static_cast<double>(gen() % 100000) - 50000.5;
+    }
+    xor_list<double> doubles(values.begin(), values.end());
+    doubles.sort();
+    std::sort(values.begin(), values.end());
+    assert(contents(doubles) == values);
+}
+
+// sort_by_key keeps equal keys in their original order, for signed keys,
+// keys taken through a member pointer, and bool keys. A narrow key only
+// looks at its own bits: 300 and 44 are the same int8_t.
+static void sort_by_key_is_stable()
+{
+    std::mt19937_64 gen(4000);
+    for (int round = 0; round < 100; ++round)
+    {
+        std::vector<record> values(gen() % 300);
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            std::int64_t key = static_cast<std::int64_t>(gen() % 21) - 10;
+            values[i] = {round % 2 ? key : key << 40, static_cast<int>(i)};
+        }
+
+        xor_list<record> list(values.begin(), values.end());
+        list.sort_by_key(&record::key);
+        std::vector<record> expected = values;
+        std::stable_sort(expected.begin(), expected.end(), [](const record &lhv, const record &rhv)
+                         { return lhv.key < rhv.key; });
+        assert(contents(list) == expected && links_agree(list));
+
+        xor_list<record> by_sign(values.begin(), values.end());
+        by_sign.sort_by_key([](const record &r)
+                            { return r.key >= 0; });
+        std::stable_partition(values.begin(), values.end(), [](const record &r)
+                              { return r.key < 0; });
+        assert(contents(by_sign) == values);
+    }
+
+    xor_list<record> narrow = {{300, 0}, {-2, 1}, {44, 2}, {-2, 3}, {300, 4}};
+    narrow.sort_by_key([](const record &r)
+                       { return static_cast<std::int8_t>(r.key); });
+    assert((contents(narrow) == std::vector<record>{{-2, 1}, {-2, 3}, {300, 0}, {44, 2}, {300, 4}}));
+}
+
+int main()
+{
+    sorts_integers();
+    small_and_other_lists();
+    sort_by_key_is_stable();
+    std::puts("xor_list sort: ok");
+}
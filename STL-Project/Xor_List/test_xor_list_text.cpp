@@ -0,0 +1,182 @@
+#include "xor_list.h"
+#include "huge_page_arena.h"
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace my_std;
+
+template <typename T, typename A>
+static std::vector<T> contents(const xor_list<T, A> &list)
+{
+    return std::vector<T>(list.begin(), list.end());
+}
+
+template <typename Fn>
+static bool throws_logic_error(Fn fn)
+{
+    try
+    {
+        fn();
+    }
+    catch (const std::logic_error &)
+    {
+        return true;
+    }
+    return false;
+}
+
+static std::string write_file(const std::string &text)
+{
+    std::string path = (std::filesystem::temp_directory_path() / "test_xor_list_text.txt").string();
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    assert(file);
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fclose(file);
+    return path;
+}
+
+// parse_from appends what it reads, takes any whitespace between numbers,
+// and leaves the list untouched when a token is not a number.
+static void parses_text()
+{
+    xor_list<int> list = {7};
+    assert(list.parse_from(" -3\t4\n\n5\r\n-2147483648 2147483647 ") == 5);
+    assert((contents(list) == std::vector<int>{7, -3, 4, 5, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()}));
+    assert(list.parse_from("") == 0 && list.parse_from(" \n\t ") == 0 && list.size() == 6);
+
+    for (std::string_view bad : {"1 2 x", "12abc", "1 +2", "3 2147483648", "4.5", "1,2", "-"})
+    {
+        assert(throws_logic_error([&]
+                                  { list.parse_from(bad); }));
+        assert(list.size() == 6 && list.back() == std::numeric_limits<int>::max());
+    }
+
+    xor_list<double> doubles;
+    assert(doubles.parse_from("1.5 -2e3 0 .25") == 4);
+    assert((contents(doubles) == std::vector<double>{1.5, -2000.0, 0.0, 0.25}));
+
+    xor_list<unsigned char> bytes;
+    assert(bytes.parse_from("0 255") == 2 && bytes.back() == 255);
+    assert(throws_logic_error([&]
+                              { bytes.parse_from("256"); }) &&
+           bytes.size() == 2);
+}
+
+// Long inputs on the default allocator are carved from packed chunks in
+// parse order; the nodes then erase, splice and free like any other.
+// Other allocators get one node per element.
+static void packs_parsed_nodes()
+{
+    std::string text;
+    std::vector<int> expected;
+    for (int i = 0; i < 5000; ++i)
+    {
+        expected.push_back(i * 7 - 9000);
+        text += std::to_string(expected.back()) + (i % 10 ? " " : "\n");
+    }
+
+    xor_list<int> list;
+    assert(list.parse_from(text) == expected.size() && contents(list) == expected);
+    auto gap = [](const int &lhv, const int &rhv)
+    {
+        return reinterpret_cast<const char *>(&rhv) - reinterpret_cast<const char *>(&lhv);
+    };
+    std::ptrdiff_t stride = gap(*list.begin(), *std::next(list.begin()));
+    std::size_t adjacent = 0;
+    for (auto it = list.begin(); std::next(it) != list.end(); ++it)
+    {
+        adjacent += gap(*it, *std::next(it)) == stride;
+    }
+    assert(stride > 0 && list.size() - 1 - adjacent <= list.size() / 255);
+
+    for (auto it = list.begin(); it != list.end();)
+    {
+        it = list.erase(it);
+        if (it != list.end())
+        {
+            ++it;
+        }
+    }
+    list.pop_front();
+    list.push_back(1);
+    xor_list<int> more;
+    more.parse_from(text);
+    list.splice_back(more);
+    assert(list.size() == 2499 + 1 + 5000 && list.back() == expected.back());
+    list.clear();
+
+    huge_page_arena arena;
+    xor_list<int, huge_page_allocator<int>> in_arena(huge_page_allocator<int>{arena});
+    assert(in_arena.parse_from(text) == expected.size() && contents(in_arena) == expected);
+}
+
+// load_text reads the file in blocks, so numbers that straddle a block
+// boundary must come through whole; stream_text hands them out in parts
+// of chunk elements with only the last one short.
+static void loads_and_streams_files()
+{
+    std::mt19937 gen(44);
+    std::string text;
+    std::vector<long long> expected;
+    while (text.size() < (std::size_t(5) << 19))
+    {
+        long long value = static_cast<long long>(gen()) * (gen() % 2 ? 1 : -1000003);
+        expected.push_back(value);
+        text += std::to_string(value);
+        text += gen() % 7 ? " " : "\n\n";
+    }
+    std::string path = write_file(text);
+
+    xor_list<long long> loaded = {1};
+    assert(loaded.load_text(path) == expected.size());
+    loaded.pop_front();
+    assert(contents(loaded) == expected);
+
+    std::vector<long long> streamed;
+    std::size_t parts = 0;
+    std::size_t total = xor_list<long long>::stream_text(path, 1000, [&](xor_list<long long> part)
+                                                          {
+                                                              assert(part.size() == 1000 || streamed.size() + part.size() == expected.size());
+                                                              streamed.insert(streamed.end(), part.begin(), part.end());
+                                                              ++parts; });
+    assert(total == expected.size() && streamed == expected);
+    assert(parts == (expected.size() + 999) / 1000);
+
+    path = write_file("1 2 3");
+    std::size_t calls = 0;
+    assert(xor_list<int>::stream_text(path, 2, [&](xor_list<int> part)
+                                      { calls += part.size() == (calls ? 1 : 2); }) == 3 &&
+           calls == 2);
+    assert(throws_logic_error([&]
+                              { xor_list<int>::stream_text(path, 0, [](xor_list<int>) {}); }));
+
+    path = write_file("");
+    xor_list<int> empty;
+    assert(empty.load_text(path) == 0 && empty.empty());
+
+    path = write_file("10 20 oops 30");
+    xor_list<int> kept = {5};
+    assert(throws_logic_error([&]
+                              { kept.load_text(path); }));
+    assert(kept.size() == 1 && kept.front() == 5);
+    std::filesystem::remove(path);
+
+    assert(throws_logic_error([&]
+                              { kept.load_text(path); }));
+}
+
+int main()
+{
+    parses_text();
+    packs_parsed_nodes();
+    loads_and_streams_files();
+    std::puts("xor_list text: ok");
+}
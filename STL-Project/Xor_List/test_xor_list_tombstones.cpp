@@ -0,0 +1,184 @@
+#include "xor_list.h"
+#include <cassert>
+#include <cstdio>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+using namespace my_std;
+
+// Counts live elements, so a tombstone (still constructed) can be told
+// apart from a node that compaction has freed.
+struct tracked
+{
+    static inline long live = 0;
+
+    int value;
+
+    tracked(int v) : value(v)
+    {
+        ++live;
+    }
+    tracked(const tracked &rhv) : value(rhv.value)
+    {
+        ++live;
+    }
+    ~tracked()
+    {
+        --live;
+    }
+    bool operator==(const tracked &rhv) const
+    {
+        return value == rhv.value;
+    }
+};
+
+static xor_list<tracked> make_list(int count)
+{
+    xor_list<tracked> list;
+    for (int i = 0; i < count; ++i)
+    {
+        list.push_back(tracked(i));
+    }
+    return list;
+}
+
+static std::vector<int> values(const xor_list<tracked> &list)
+{
+    std::vector<int> result;
+    for (const auto &elem : list)
+    {
+        result.push_back(elem.value);
+    }
+    return result;
+}
+
+// A marked node stays allocated but no longer counts or shows up.
+static void marked_nodes_are_skipped()
+{
+    {
+        xor_list<tracked> list = make_list(6);
+        auto it = list.mark_erased(std::next(list.begin(), 2));
+        assert(it->value == 3);
+        it = list.mark_erased(it);
+        assert(it->value == 4);
+
+        assert(list.size() == 4 && tracked::live == 6);
+        assert((values(list) == std::vector<int>{0, 1, 4, 5}));
+        assert(std::distance(list.begin(), list.end()) == 4);
+
+        std::vector<int> backwards;
+        for (auto rit = list.rbegin(); rit != list.rend(); ++rit)
+        {
+            backwards.push_back(rit->value);
+        }
+        assert((backwards == std::vector<int>{5, 4, 1, 0}));
+        assert(*std::prev(list.find(tracked(4))) == tracked(1));
+        assert(list.find(tracked(2)) == list.end());
+    }
+    assert(tracked::live == 0);
+}
+
+// Erasing at either end unlinks at once, along with any tombstones that
+// become the new end.
+static void ends_are_unlinked()
+{
+    xor_list<tracked> list = make_list(6);
+    for (auto it = std::next(list.begin()); it->value != 5;)
+    {
+        it = list.mark_erased(it);
+    }
+    assert((values(list) == std::vector<int>{0, 5}) && tracked::live == 6);
+
+    assert(list.mark_erased(list.begin())->value == 5);
+    assert(list.size() == 1 && tracked::live == 1);
+    assert(list.front() == tracked(5));
+
+    assert(list.mark_erased(list.begin()) == list.end());
+    assert(list.empty() && tracked::live == 0);
+
+    list = make_list(4);
+    list.mark_erased(std::next(list.begin(), 2));
+    assert(list.mark_erased(std::prev(list.end())) == list.end());
+    assert(list.back().value == 1 && tracked::live == 2);
+
+    bool threw = false;
+    try
+    {
+        list.mark_erased(list.end());
+    }
+    catch (const std::logic_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+// Once tombstones exceed compaction_ratio of the nodes, the list frees
+// them all; the returned iterator still names the next element.
+static void compacts_past_ratio()
+{
+    xor_list<tracked> list = make_list(10);
+    list.set_compaction_ratio(0.25);
+    assert(list.compaction_ratio() == 0.25);
+
+    auto it = std::next(list.begin());
+    for (int i = 0; i < 2; ++i)
+    {
+        it = list.mark_erased(it);
+    }
+    assert(tracked::live == 10 && list.size() == 8);
+
+    it = list.mark_erased(it);
+    assert(tracked::live == 7 && list.size() == 7);
+    assert(it->value == 4 && *std::prev(it) == tracked(0));
+    assert((values(list) == std::vector<int>{0, 4, 5, 6, 7, 8, 9}));
+
+    // With compaction off, tombstones pile up until compact() is called,
+    // or a ratio they already exceed is set.
+    list.set_compaction_ratio(0.0);
+    for (it = std::next(list.begin()); std::next(it) != list.end();)
+    {
+        it = list.mark_erased(it);
+    }
+    assert(list.size() == 2 && tracked::live == 7);
+    list.compact();
+    assert(tracked::live == 2 && (values(list) == std::vector<int>{0, 9}));
+    list.compact();
+
+    list.push_back(tracked(10));
+    list.push_back(tracked(11));
+    list.mark_erased(std::next(list.begin()));
+    assert(tracked::live == 4);
+    list.set_compaction_ratio(0.2);
+    assert(tracked::live == 3 && (values(list) == std::vector<int>{0, 10, 11}));
+}
+
+// Copies drop tombstones; moves and splices carry them along.
+static void tombstones_follow_the_nodes()
+{
+    xor_list<tracked> list = make_list(5);
+    list.mark_erased(std::next(list.begin(), 2));
+
+    xor_list<tracked> copy = list;
+    assert(copy.size() == 4 && tracked::live == 9);
+
+    xor_list<tracked> moved = std::move(list);
+    assert(moved.size() == 4 && list.empty());
+
+    copy.splice_back(moved);
+    assert(copy.size() == 8 && moved.empty());
+    copy.compact();
+    assert(tracked::live == 8);
+    assert((values(copy) == std::vector<int>{0, 1, 3, 4, 0, 1, 3, 4}));
+}
+
+int main()
+{
+    marked_nodes_are_skipped();
+    ends_are_unlinked();
+    compacts_past_ratio();
+    tombstones_follow_the_nodes();
+    assert(tracked::live == 0);
+    std::puts("xor_list tombstones: ok");
+}
@@ -0,0 +1,204 @@
+#include "xor_lru_cache.h"
+#include <cassert>
+#include <cstdio>
+#include <list>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+using namespace my_std;
+
+// Reference LRU: most recently used at the front.
+template <typename K, typename V>
+class reference_lru
+{
+public:
+    reference_lru(std::size_t capacity) : m_capacity(capacity) {}
+
+    V *get(const K &key)
+    {
+        auto found = m_index.find(key);
+        if (found == m_index.end())
+        {
+            return nullptr;
+        }
+        m_order.splice(m_order.begin(), m_order, found->second);
+        return &found->second->second;
+    }
+
+    const V *peek(const K &key) const
+    {
+        auto found = m_index.find(key);
+        return found == m_index.end() ? nullptr : &found->second->second;
+    }
+
+    void put(const K &key, const V &value)
+    {
+        if (V *existing = get(key))
+        {
+            *existing = value;
+            return;
+        }
+        m_order.emplace_front(key, value);
+        m_index[key] = m_order.begin();
+        if (m_order.size() > m_capacity)
+        {
+            m_index.erase(m_order.back().first);
+            m_order.pop_back();
+        }
+    }
+
+    bool erase(const K &key)
+    {
+        auto found = m_index.find(key);
+        if (found == m_index.end())
+        {
+            return false;
+        }
+        m_order.erase(found->second);
+        m_index.erase(found);
+        return true;
+    }
+
+    std::size_t size() const
+    {
+        return m_order.size();
+    }
+
+private:
+    std::size_t m_capacity;
+    std::list<std::pair<K, V>> m_order;
+    std::unordered_map<K, typename std::list<std::pair<K, V>>::iterator> m_index;
+};
+
+// Sends every key to one of four home slots, so probe runs are long and
+// erase has to shift entries back along them.
+struct clustered_hash
+{
+    std::size_t operator()(int key) const
+    {
+        return static_cast<std::size_t>(key % 4);
+    }
+};
+
+template <typename Hash>
+static void matches_reference(std::uint32_t seed, std::size_t capacity, int keys)
+{
+    std::mt19937 gen(seed);
+    xor_lru_cache<int, int, Hash> cache(capacity);
+    reference_lru<int, int> expected(capacity);
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        int key = static_cast<int>(gen() % keys);
+        switch (gen() % 8)
+        {
+        case 0:
+        case 1:
+        case 2:
+            cache.put(key, step);
+            expected.put(key, step);
+            break;
+        case 3:
+        case 4:
+        {
+            int *got = cache.get(key);
+            int *want = expected.get(key);
+            assert((got == nullptr) == (want == nullptr) && (!got || *got == *want));
+            break;
+        }
+        case 5:
+        {
+            const int *got = cache.peek(key);
+            const int *want = expected.peek(key);
+            assert((got == nullptr) == (want == nullptr) && (!got || *got == *want));
+            break;
+        }
+        default:
+            assert(cache.erase(key) == expected.erase(key));
+            break;
+        }
+        assert(cache.size() == expected.size() && cache.usage() == cache.size());
+
+        // A full sweep with peek, which leaves the recency order alone.
+        if (step % 512 == 0)
+        {
+            for (int k = 0; k < keys; ++k)
+            {
+                const int *got = cache.peek(k);
+                const int *want = expected.peek(k);
+                assert(cache.contains(k) == (want != nullptr));
+                assert((got == nullptr) == (want == nullptr) && (!got || *got == *want));
+            }
+        }
+    }
+}
+
+// Entries leave from the least recently used end; get and put both count
+// as a use, peek and contains do not.
+static void evicts_least_recent()
+{
+    xor_lru_cache<std::string, int> cache(3);
+    cache.put("a", 1);
+    cache.put("b", 2);
+    cache.put("c", 3);
+    assert(*cache.get("a") == 1);
+    assert(*cache.peek("b") == 2 && cache.contains("b"));
+
+    cache.put("d", 4);
+    assert(!cache.contains("b") && cache.size() == 3);
+    cache.put("c", 30);
+    cache.put("e", 5);
+    assert(!cache.contains("a") && *cache.peek("c") == 30);
+    assert(cache.contains("d") && cache.contains("e"));
+
+    assert(cache.erase("c") && !cache.erase("c"));
+    cache.put("f", 6);
+    cache.put("g", 7);
+    assert(!cache.contains("d") && cache.size() == 3);
+
+    cache.clear();
+    assert(cache.size() == 0 && cache.usage() == 0 && !cache.contains("e"));
+    cache.put("h", 8);
+    assert(*cache.get("h") == 8);
+}
+
+// In byte mode each entry is charged its node, its index slots and what
+// the weigher reports; an entry larger than the budget does not stay.
+static void evicts_by_weight()
+{
+    auto weigh = [](const int &, const std::string &value)
+    {
+        return value.size();
+    };
+    xor_lru_cache<int, std::string> probe(1 << 20, xor_lru_cache<int, std::string>::capacity_mode::bytes, weigh);
+    probe.put(0, "");
+    std::size_t overhead = probe.usage();
+
+    xor_lru_cache<int, std::string> cache(3 * overhead + 100, xor_lru_cache<int, std::string>::capacity_mode::bytes, weigh);
+    cache.put(1, std::string(40, 'x'));
+    cache.put(2, std::string(40, 'y'));
+    assert(cache.usage() == 2 * overhead + 80);
+    cache.put(3, std::string(40, 'z'));
+    assert(!cache.contains(1) && cache.size() == 2);
+
+    cache.put(2, "");
+    assert(cache.usage() == 2 * overhead + 40);
+    cache.put(4, std::string(50, 'w'));
+    assert(cache.size() == 3 && cache.contains(3));
+
+    cache.put(5, std::string(1000, 'v'));
+    assert(cache.size() == 0 && cache.usage() == 0);
+}
+
+int main()
+{
+    evicts_least_recent();
+    evicts_by_weight();
+    matches_reference<std::hash<int>>(33, 16, 48);
+    matches_reference<std::hash<int>>(34, 100, 120);
+    matches_reference<clustered_hash>(35, 12, 40);
+    matches_reference<clustered_hash>(36, 1, 6);
+    std::puts("xor_lru_cache: ok");
+}
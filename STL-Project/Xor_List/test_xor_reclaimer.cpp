@@ -0,0 +1,146 @@
+#include "xor_reclaimer.h"
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <iterator>
+#include <thread>
+
+using namespace my_std;
+
+// Counts live objects and those destroyed off the main thread.
+struct tracked
+{
+    static inline std::atomic<long> live{0};
+    static inline std::atomic<long> destroyed_remotely{0};
+    static inline std::thread::id main_thread;
+
+    int value;
+
+    tracked(int v) : value(v)
+    {
+        ++live;
+    }
+    tracked(const tracked &rhv) : value(rhv.value)
+    {
+        ++live;
+    }
+    ~tracked()
+    {
+        --live;
+        if (std::this_thread::get_id() != main_thread)
+        {
+            ++destroyed_remotely;
+        }
+    }
+};
+
+// Each call frees at most budget nodes, tombstones included, and the list
+// stays usable between calls.
+static void incremental_clear()
+{
+    {
+        xor_list<tracked> list;
+        for (int i = 0; i < 1000; ++i)
+        {
+            list.push_back(tracked(i));
+        }
+        list.mark_erased(std::next(list.begin(), 5));
+
+        int calls = 0;
+        long before = tracked::live;
+        while (!list.clear_incremental(100))
+        {
+            ++calls;
+            assert(before - tracked::live == 100);
+            before = tracked::live;
+            assert(list.size() == 999 - 100 * static_cast<std::size_t>(calls) + 1);
+        }
+        assert(list.empty() && tracked::live == 0 && calls == 9);
+
+        // A run of 300 tombstones is freed across several calls instead of
+        // all at once behind the first live node.
+        for (int i = 0; i < 400; ++i)
+        {
+            list.push_back(tracked(i));
+        }
+        for (int i = 0; i < 300; ++i)
+        {
+            list.mark_erased(std::next(list.begin()));
+        }
+        assert(list.size() == 100 && tracked::live == 400);
+        calls = 0;
+        before = tracked::live;
+        while (!list.clear_incremental(50))
+        {
+            ++calls;
+            assert(before - tracked::live == 50);
+            before = tracked::live;
+            assert(list.front().value == (calls <= 6 ? 0 : 400 - before));
+            assert(static_cast<long>(std::distance(list.begin(), list.end())) == static_cast<long>(list.size()));
+        }
+        assert(tracked::live == 0);
+
+        list.push_back(tracked(1));
+        assert(!list.clear_incremental(0) && list.size() == 1);
+    }
+    assert(tracked::live == 0);
+}
+
+// A retired list is emptied at once and its elements are destroyed on the
+// reclaimer's thread; the list stays usable.
+static void frees_on_worker()
+{
+    xor_reclaimer reclaimer;
+    {
+        xor_list<tracked> list;
+        for (int i = 0; i < 10000; ++i)
+        {
+            list.push_back(tracked(i));
+        }
+        assert(reclaimer.retire(list));
+        assert(list.empty());
+        list.push_back(tracked(1));
+        assert(list.size() == 1);
+    }
+    reclaimer.drain();
+    assert(tracked::live == 0 && tracked::destroyed_remotely == 10000);
+
+    reclaimer_stats stats = reclaimer.stats();
+    assert(stats.retired_lists == 1 && stats.reclaimed_lists == 1);
+    assert(stats.retired_elements == 10000 && stats.reclaimed_elements == 10000);
+    assert(stats.pending == 0);
+}
+
+// Past capacity the list is cleared inline; either way nothing leaks and
+// the counters add up.
+static void falls_back_when_full()
+{
+    xor_reclaimer reclaimer(1);
+    int queued = 0;
+    for (int round = 0; round < 50; ++round)
+    {
+        xor_list<tracked> list;
+        for (int i = 0; i < 2000; ++i)
+        {
+            list.push_back(tracked(i));
+        }
+        queued += reclaimer.retire(list);
+        assert(list.empty());
+    }
+    reclaimer.drain();
+
+    reclaimer_stats stats = reclaimer.stats();
+    assert(tracked::live == 0);
+    assert(stats.retired_lists == static_cast<std::size_t>(queued));
+    assert(stats.retired_lists + stats.inline_fallbacks == 50);
+    assert(stats.reclaimed_lists == stats.retired_lists && stats.peak_pending <= 1);
+}
+
+int main()
+{
+    tracked::main_thread = std::this_thread::get_id();
+    incremental_clear();
+    frees_on_worker();
+    falls_back_when_full();
+    std::puts("xor_reclaimer: ok");
+}
@@ -0,0 +1,185 @@
+#ifndef XOR_THREAD_CACHE_ALLOCATOR_H
+#define XOR_THREAD_CACHE_ALLOCATOR_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace my_std
+{
+    struct thread_cache_stats
+    {
+        std::size_t allocations = 0;
+        std::size_t deallocations = 0;
+        std::size_t local_hits = 0;
+        std::size_t remote_frees = 0;
+        std::size_t remote_reclaims = 0;
+        std::size_t depot_refills = 0;
+        std::size_t depot_returns = 0;
+        std::size_t chunks = 0;
+    };
+
+    // Every thread_node_pool instantiation registers here so that
+    // thread_cache_allocator<T>::stats() can report across all node sizes.
+    class thread_cache_pools
+    {
+    public:
+        using stats_function = thread_cache_stats (*)();
+
+        static void enroll(stats_function fn);
+        static thread_cache_stats stats();
+
+    private:
+        static std::mutex &mutex();
+        static std::vector<stats_function> &pools();
+    };
+
+    // Blocks are carved from aligned chunks, and every chunk records the
+    // thread cache that carved it. Freeing a block from its owning thread
+    // is a push onto a private list. Freeing it from another thread queues
+    // it in a small outgoing batch that is pushed in one CAS onto the
+    // owner's remote stack, which the owner reclaims whole when its own
+    // list runs dry. Private lists are bounded; surplus moves in batches to
+    // a shared depot that refills threads that only allocate. A thread's
+    // cache is parked for reuse when the thread exits; blocks freed after
+    // that, or freed into a parked cache's remote stack, are drained into
+    // the depot. Chunks are kept for reuse for the life of the process.
+    template <std::size_t BlockSize>
+    class thread_node_pool
+    {
+    public:
+        using size_type = std::size_t;
+
+        static constexpr size_type cache_limit = 512;
+        static constexpr size_type batch_size = 64;
+
+    public:
+        static void *allocate();
+        static void deallocate(void *ptr);
+        static thread_cache_stats stats();
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock *m_next;
+        };
+
+        struct Counter
+        {
+            std::atomic<size_type> m_value{0};
+            void bump();
+            size_type get() const;
+        };
+
+        struct Cache
+        {
+            FreeBlock *m_local = nullptr;
+            size_type m_local_count = 0;
+            std::atomic<FreeBlock *> m_remote{nullptr};
+
+            char *m_cursor = nullptr;
+            char *m_limit = nullptr;
+
+            Cache *m_out_owner = nullptr;
+            FreeBlock *m_out_head = nullptr;
+            FreeBlock *m_out_tail = nullptr;
+            size_type m_out_count = 0;
+
+            Counter m_allocations;
+            Counter m_deallocations;
+            Counter m_local_hits;
+            Counter m_remote_frees;
+            Counter m_remote_reclaims;
+            Counter m_depot_refills;
+            Counter m_depot_returns;
+            Counter m_chunks;
+
+            Cache *m_next_idle = nullptr;
+        };
+
+        struct ChunkHeader
+        {
+            Cache *m_owner;
+        };
+
+        struct Batch
+        {
+            FreeBlock *m_head;
+            size_type m_count;
+        };
+
+        struct Registry
+        {
+            std::mutex m_mutex;
+            std::vector<Cache *> m_caches;
+            Cache *m_idle = nullptr;
+            std::vector<Batch> m_depot;
+            std::atomic<size_type> m_exited_frees{0};
+        };
+
+        struct ThreadHandle
+        {
+            ~ThreadHandle();
+        };
+
+        static constexpr size_type header_size = (sizeof(ChunkHeader) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+        static constexpr size_type chunk_size = BlockSize * 256 + header_size > (size_type(64) << 10) ? std::bit_ceil(BlockSize * 256 + header_size) : (size_type(64) << 10);
+
+        static Registry &registry();
+        static Cache *local_cache();
+        static Cache *acquire();
+        static void release(Cache *cache);
+        static void drain_idle(Registry &reg);
+        static void *allocate_from(Cache *cache);
+        static Cache *owner_of(void *ptr);
+
+        static void *carve(Cache *cache);
+        static bool reclaim_remote(Cache *cache);
+        static bool refill_from_depot(Cache *cache);
+        static void return_to_depot(Cache *cache, size_type count);
+        static void flush_outgoing(Cache *cache);
+        static void push_remote(Cache *owner, FreeBlock *head, FreeBlock *tail);
+
+        static thread_local Cache *t_cache;
+        static thread_local bool t_exited;
+    };
+
+    template <typename T>
+    class thread_cache_allocator
+    {
+    public:
+        template <typename U>
+        struct rebind
+        {
+            using other = thread_cache_allocator<U>;
+        };
+
+    private:
+        static constexpr std::size_t block_size = sizeof(T) < sizeof(void *) ? sizeof(void *) : sizeof(T);
+        using pool_type = thread_node_pool<block_size>;
+
+    public:
+        thread_cache_allocator() = default;
+        template <typename U>
+        thread_cache_allocator(const thread_cache_allocator<U> &);
+
+        T *allocate();
+        template <typename... Args>
+        void construct(T *ptr, Args &&...args);
+        void destroy(T *ptr);
+        void deallocate(T *ptr);
+
+        static thread_cache_stats stats();
+
+        template <typename U>
+        bool operator==(const thread_cache_allocator<U> &) const;
+    };
+}
+#include "thread_cache_allocator.hpp"
+#endif
@@ -0,0 +1,423 @@
+#ifndef XOR_THREAD_CACHE_ALLOCATOR_HPP
+#define XOR_THREAD_CACHE_ALLOCATOR_HPP
+#include "thread_cache_allocator.h"
+
+namespace my_std
+{
+    inline void thread_cache_pools::enroll(stats_function fn)
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        pools().push_back(fn);
+    }
+
+    inline thread_cache_stats thread_cache_pools::stats()
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        thread_cache_stats result;
+        for (stats_function fn : pools())
+        {
+            thread_cache_stats part = fn();
+            result.allocations += part.allocations;
+            result.deallocations += part.deallocations;
+            result.local_hits += part.local_hits;
+            result.remote_frees += part.remote_frees;
+            result.remote_reclaims += part.remote_reclaims;
+            result.depot_refills += part.depot_refills;
+            result.depot_returns += part.depot_returns;
+            result.chunks += part.chunks;
+        }
+        return result;
+    }
+
+    inline std::mutex &thread_cache_pools::mutex()
+    {
+        static std::mutex *instance = new std::mutex();
+        return *instance;
+    }
+
+    inline std::vector<thread_cache_pools::stats_function> &thread_cache_pools::pools()
+    {
+        static std::vector<stats_function> *instance = new std::vector<stats_function>();
+        return *instance;
+    }
+
+    template <std::size_t BlockSize>
+    thread_local typename thread_node_pool<BlockSize>::Cache *thread_node_pool<BlockSize>::t_cache = nullptr;
+
+    template <std::size_t BlockSize>
+    thread_local bool thread_node_pool<BlockSize>::t_exited = false;
+
+    template <std::size_t BlockSize>
+    void thread_node_pool<BlockSize>::Counter::bump()
+    {
+        m_value.store(m_value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    template <std::size_t BlockSize>
+    typename thread_node_pool<BlockSize>::size_type thread_node_pool<BlockSize>::Counter::get() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+    template <std::size_t BlockSize>
+    thread_node_pool<BlockSize>::ThreadHandle::~ThreadHandle()
+    {
+        if (t_cache)
+        {
+            release(t_cache);
+            t_cache = nullptr;
+        }
+        t_exited = true;
+    }
+
+    template <std::size_t BlockSize>
+    void *thread_node_pool<BlockSize>::allocate()
+    {
+        Cache *cache = local_cache();
+        if (cache)
+        {
+            return allocate_from(cache);
+        }
+
+        cache = acquire();
+        void *ptr = allocate_from(cache);
+        release(cache);
+        return ptr;
+    }
+
+    template <std::size_t BlockSize>
+    void *thread_node_pool<BlockSize>::allocate_from(Cache *cache)
+    {
+        cache->m_allocations.bump();
+
+        if (cache->m_local)
+        {
+            cache->m_local_hits.bump();
+        }
+        else if (!reclaim_remote(cache) && !refill_from_depot(cache))
+        {
+            return carve(cache);
+        }
+
+        FreeBlock *block = cache->m_local;
+        cache->m_local = block->m_next;
+        --cache->m_local_count;
+        return block;
+    }
+
+    template <std::size_t BlockSize>
+    void thread_node_pool<BlockSize>::deallocate(void *ptr)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        Cache *cache = local_cache();
+        Cache *owner = owner_of(ptr);
+        FreeBlock *block = ::new (ptr) FreeBlock{nullptr};
+        if (!cache)
+        {
+            registry().m_exited_frees.fetch_add(1, std::memory_order_relaxed);
+            push_remote(owner, block, block);
+            return;
+        }
+
+        cache->m_deallocations.bump();
+
+        if (owner == cache)
+        {
+            block->m_next = cache->m_local;
+            cache->m_local = block;
+            if (++cache->m_local_count > cache_limit)
+            {
+                return_to_depot(cache, batch_size);
+            }
+            return;
+        }
+
+        cache->m_remote_frees.bump();
+        if (cache->m_out_owner != owner)
+        {
+            flush_outgoing(cache);
+            cache->m_out_owner = owner;
+        }
+        block->m_next = cache->m_out_head;
+        cache->m_out_head = block;
+        if (!cache->m_out_tail)
+        {
+            cache->m_out_tail = block;
+        }
+        if (++cache->m_out_count == batch_size)
+        {
+            flush_outgoing(cache);
+        }
+    }
+
+    template <std::size_t BlockSize>
+    thread_cache_stats thread_node_pool<BlockSize>::stats()
+    {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.m_mutex);
+
+        thread_cache_stats result;
+        for (const Cache *cache : reg.m_caches)
+        {
+            result.allocations += cache->m_allocations.get();
+            result.deallocations += cache->m_deallocations.get();
+            result.local_hits += cache->m_local_hits.get();
+            result.remote_frees += cache->m_remote_frees.get();
+            result.remote_reclaims += cache->m_remote_reclaims.get();
+            result.depot_refills += cache->m_depot_refills.get();
+            result.depot_returns += cache->m_depot_returns.get();
+            result.chunks += cache->m_chunks.get();
+        }
+        size_type exited_frees = reg.m_exited_frees.load(std::memory_order_relaxed);
+        result.deallocations += exited_frees;
+        result.remote_frees += exited_frees;
+        return result;
+    }
+
+    template <std::size_t BlockSize>
+    typename thread_node_pool<BlockSize>::Registry &thread_node_pool<BlockSize>::registry()
+    {
+        static Registry *instance = []
+        {
+            thread_cache_pools::enroll(&thread_node_pool::stats);
+            return new Registry();
+        }();
+        return *instance;
+    }
+
+    template <std::size_t BlockSize>
+    typename thread_node_pool<BlockSize>::Cache *thread_node_pool<BlockSize>::local_cache()
+    {
+        if (t_cache || t_exited)
+        {
+            return t_cache;
+        }
+        t_cache = acquire();
+        static thread_local ThreadHandle handle;
+        (void)handle;
+        return t_cache;
+    }
+
+    template <std::size_t BlockSize>
+    typename thread_node_pool<BlockSize>::Cache *thread_node_pool<BlockSize>::acquire()
+    {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.m_mutex);
+        drain_idle(reg);
+        if (reg.m_idle)
+        {
+            Cache *cache = reg.m_idle;
+            reg.m_idle = cache->m_next_idle;
+            cache->m_next_idle = nullptr;
+            return cache;
+        }
+        Cache *cache = new Cache();
+        reg.m_caches.push_back(cache);
+        return cache;
+    }
+
+    template <std::size_t BlockSize>
+    void thread_node_pool<BlockSize>::release(Cache *cache)
+    {
+        flush_outgoing(cache);
+        while (cache->m_local || reclaim_remote(cache))
+        {
+            return_to_depot(cache, batch_size);
+        }
+
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.m_mutex);
+        cache->m_next_idle = reg.m_idle;
+        reg.m_idle = cache;
+        drain_idle(reg);
+    }
+
+    // Remote frees keep arriving at a parked cache, from other threads and
+    // from its own thread after exit. Called with the registry locked.
+    template <std::size_t BlockSize>
+    void thread_node_pool<BlockSize>::drain_idle(Registry &reg)
+    {
+        for (Cache *cache = reg.m_idle; cache; cache = cache->m_next_idle)
+        {
+            FreeBlock *head = cache->m_remote.exchange(nullptr, std::memory_order_acquire);
+            if (!head)
+            {
+                continue;
+            }
+            size_type count = 1;
+            for (FreeBlock *block = head; block->m_next; block = block->m_next)
+            {
+                ++count;
+            }
+            reg.m_depot.push_back(Batch{head, count});
+        }
+    }
+
+    template <std::size_t BlockSize>
+    typename thread_node_pool<BlockSize>::Cache *thread_node_pool<BlockSize>::owner_of(void *ptr)
+    {
+        std::uintptr_t chunk = reinterpret_cast<std::uintptr_t>(ptr) & ~(static_cast<std::uintptr_t>(chunk_size) - 1);
+        return reinterpret_cast<ChunkHeader *>(chunk)->m_owner;
+    }
+
+    template <std::size_t BlockSize>
+    void *thread_node_pool<BlockSize>::carve(Cache *cache)
+    {
+        if (static_cast<size_type>(cache->m_limit - cache->m_cursor) < BlockSize)
+        {
+            char *chunk = static_cast<char *>(std::aligned_alloc(chunk_size, chunk_size));
+            if (!chunk)
+            {
+                throw std::bad_alloc();
+            }
+            ::new (chunk) ChunkHeader{cache};
+            cache->m_cursor = chunk + header_size;
+            cache->m_limit = chunk + chunk_size;
+            cache->m_chunks.bump();
+        }
+        void *ptr = cache->m_cursor;
+        cache->m_cursor += BlockSize;
+        return ptr;
+    }
+
+    template <std::size_t BlockSize>
+    bool thread_node_pool<BlockSize>::reclaim_remote(Cache *cache)
+    {
+        FreeBlock *head = cache->m_remote.exchange(nullptr, std::memory_order_acquire);
+        if (!head)
+        {
+            return false;
+        }
+
+        size_type count = 0;
+        FreeBlock *tail = head;
+        for (;; tail = tail->m_next)
+        {
+            ++count;
+            if (!tail->m_next)
+            {
+                break;
+            }
+        }
+        tail->m_next = cache->m_local;
+        cache->m_local = head;
+        cache->m_local_count += count;
+        cache->m_remote_reclaims.bump();
+        return true;
+    }
+
+    template <std::size_t BlockSize>
+    bool thread_node_pool<BlockSize>::refill_from_depot(Cache *cache)
+    {
+        Registry &reg = registry();
+        Batch batch;
+        {
+            std::lock_guard<std::mutex> lock(reg.m_mutex);
+            if (reg.m_depot.empty())
+            {
+                return false;
+            }
+            batch = reg.m_depot.back();
+            reg.m_depot.pop_back();
+        }
+        cache->m_local = batch.m_head;
+        cache->m_local_count = batch.m_count;
+        cache->m_depot_refills.bump();
+        return true;
+    }
+
+    template <std::size_t BlockSize>
+    void thread_node_pool<BlockSize>::return_to_depot(Cache *cache, size_type count)
+    {
+        FreeBlock *head = cache->m_local;
+        FreeBlock *tail = head;
+        size_type taken = 1;
+        while (taken < count && tail->m_next)
+        {
+            tail = tail->m_next;
+            ++taken;
+        }
+        cache->m_local = tail->m_next;
+        cache->m_local_count -= taken;
+        tail->m_next = nullptr;
+
+        Registry &reg = registry();
+        {
+            std::lock_guard<std::mutex> lock(reg.m_mutex);
+            reg.m_depot.push_back(Batch{head, taken});
+        }
+        cache->m_depot_returns.bump();
+    }
+
+    template <std::size_t BlockSize>
+    void thread_node_pool<BlockSize>::flush_outgoing(Cache *cache)
+    {
+        if (!cache->m_out_head)
+        {
+            return;
+        }
+        push_remote(cache->m_out_owner, cache->m_out_head, cache->m_out_tail);
+        cache->m_out_head = cache->m_out_tail = nullptr;
+        cache->m_out_count = 0;
+    }
+
+    template <std::size_t BlockSize>
+    void thread_node_pool<BlockSize>::push_remote(Cache *owner, FreeBlock *head, FreeBlock *tail)
+    {
+        FreeBlock *old = owner->m_remote.load(std::memory_order_relaxed);
+        do
+        {
+            tail->m_next = old;
+        } while (!owner->m_remote.compare_exchange_weak(old, head, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // =====================================thread cache allocator ============================================
+
+    template <typename T>
+    template <typename U>
+    thread_cache_allocator<T>::thread_cache_allocator(const thread_cache_allocator<U> &) {}
+
+    template <typename T>
+    T *thread_cache_allocator<T>::allocate()
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "thread_cache_allocator does not support over-aligned types");
+        return static_cast<T *>(pool_type::allocate());
+    }
+
+    template <typename T>
+    template <typename... Args>
+    void thread_cache_allocator<T>::construct(T *ptr, Args &&...args)
+    {
+        ::new (ptr) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    void thread_cache_allocator<T>::destroy(T *ptr)
+    {
+        ptr->~T();
+    }
+
+    template <typename T>
+    void thread_cache_allocator<T>::deallocate(T *ptr)
+    {
+        pool_type::deallocate(ptr);
+    }
+
+    template <typename T>
+    thread_cache_stats thread_cache_allocator<T>::stats()
+    {
+        return thread_cache_pools::stats();
+    }
+
+    template <typename T>
+    template <typename U>
+    bool thread_cache_allocator<T>::operator==(const thread_cache_allocator<U> &) const
+    {
+        return true;
+    }
+}
+#endif
@@ -0,0 +1,56 @@
+#ifndef XOR_WORK_STEALING_XOR_DEQUE_H
+#define XOR_WORK_STEALING_XOR_DEQUE_H
+
+#include <atomic>
+#include <mutex>
+#include "xor_list.h"
+
+namespace my_std
+{
+    // The owner works on a private xor_list without locking. Thieves only see
+    // the shared list, which holds the oldest tasks. The owner moves the older
+    // half of its private list there on a push or pop once a thief has found
+    // the shared list dry, or once the private list reaches publish_threshold,
+    // so an owner that blocks strands fewer than publish_threshold tasks.
+    template <typename T, typename allocator = Allocator<T>>
+    class work_stealing_xor_deque
+    {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using list_type = xor_list<T, allocator>;
+
+        static constexpr size_type publish_threshold = 256;
+
+    public:
+        work_stealing_xor_deque() = default;
+        work_stealing_xor_deque(const work_stealing_xor_deque &) = delete;
+        work_stealing_xor_deque &operator=(const work_stealing_xor_deque &) = delete;
+
+    public:
+        void push(const_reference val);
+        bool pop(reference out);
+
+        bool steal(reference out);
+        list_type steal_half();
+
+        size_type size() const;
+        bool empty() const;
+
+    private:
+        void publish();
+        void on_owner_op();
+
+    private:
+        list_type m_local;
+        list_type m_shared;
+        mutable std::mutex m_mutex;
+        std::atomic<size_type> m_local_size{0};
+        std::atomic<size_type> m_shared_size{0};
+        std::atomic<bool> m_steal_request{false};
+    };
+}
+#include "work_stealing_xor_deque.hpp"
+#endif
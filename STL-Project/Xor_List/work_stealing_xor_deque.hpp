@@ -0,0 +1,110 @@
+#ifndef XOR_WORK_STEALING_XOR_DEQUE_HPP
+#define XOR_WORK_STEALING_XOR_DEQUE_HPP
+#include "work_stealing_xor_deque.h"
+
+namespace my_std
+{
+    template <typename T, typename allocator>
+    void work_stealing_xor_deque<T, allocator>::push(const_reference val)
+    {
+        m_local.push_back(val);
+        on_owner_op();
+    }
+
+    template <typename T, typename allocator>
+    bool work_stealing_xor_deque<T, allocator>::pop(reference out)
+    {
+        if (!m_local.empty())
+        {
+            out = std::move(m_local.back());
+            m_local.pop_back();
+            on_owner_op();
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_shared.empty())
+        {
+            return false;
+        }
+        out = std::move(m_shared.back());
+        m_shared.pop_back();
+        m_shared_size.store(m_shared.size(), std::memory_order_release);
+        return true;
+    }
+
+    template <typename T, typename allocator>
+    bool work_stealing_xor_deque<T, allocator>::steal(reference out)
+    {
+        if (m_shared_size.load(std::memory_order_acquire) == 0)
+        {
+            m_steal_request.store(true, std::memory_order_relaxed);
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_shared.empty())
+        {
+            m_steal_request.store(true, std::memory_order_relaxed);
+            return false;
+        }
+        out = std::move(m_shared.front());
+        m_shared.pop_front();
+        m_shared_size.store(m_shared.size(), std::memory_order_release);
+        return true;
+    }
+
+    template <typename T, typename allocator>
+    typename work_stealing_xor_deque<T, allocator>::list_type work_stealing_xor_deque<T, allocator>::steal_half()
+    {
+        if (m_shared_size.load(std::memory_order_acquire) == 0)
+        {
+            m_steal_request.store(true, std::memory_order_relaxed);
+            return list_type();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        list_type stolen = m_shared.split_front((m_shared.size() + 1) / 2);
+        if (stolen.empty())
+        {
+            m_steal_request.store(true, std::memory_order_relaxed);
+        }
+        m_shared_size.store(m_shared.size(), std::memory_order_release);
+        return stolen;
+    }
+
+    template <typename T, typename allocator>
+    typename work_stealing_xor_deque<T, allocator>::size_type work_stealing_xor_deque<T, allocator>::size() const
+    {
+        return m_local_size.load(std::memory_order_relaxed) + m_shared_size.load(std::memory_order_relaxed);
+    }
+
+    template <typename T, typename allocator>
+    bool work_stealing_xor_deque<T, allocator>::empty() const
+    {
+        return size() == 0;
+    }
+
+    template <typename T, typename allocator>
+    void work_stealing_xor_deque<T, allocator>::on_owner_op()
+    {
+        size_type local = m_local.size();
+        if (local && (local >= publish_threshold || m_steal_request.load(std::memory_order_relaxed)))
+        {
+            publish();
+        }
+        m_local_size.store(m_local.size(), std::memory_order_relaxed);
+    }
+
+    template <typename T, typename allocator>
+    void work_stealing_xor_deque<T, allocator>::publish()
+    {
+        list_type oldest = m_local.split_front((m_local.size() + 1) / 2);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shared.splice_back(oldest);
+        m_shared_size.store(m_shared.size(), std::memory_order_release);
+        m_steal_request.store(false, std::memory_order_relaxed);
+    }
+}
+#endif
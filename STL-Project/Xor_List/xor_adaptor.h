@@ -0,0 +1,51 @@
+#ifndef XOR_XOR_ADAPTOR_H
+#define XOR_XOR_ADAPTOR_H
+
+#include "xor_list.h"
+
+namespace my_std
+{
+    // Batched push and pop over one xor_list, shared by xor_queue and
+    // xor_stack. Elements go in at the back and come out at the front, or
+    // at the back when lifo is set; batches come out in the order single
+    // pops would return them.
+    template <typename T, typename allocator, bool lifo>
+    class xor_adaptor
+    {
+    public:
+        using list_type = xor_list<T, allocator>;
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T &;
+        using const_reference = const T &;
+
+    public:
+        xor_adaptor() = default;
+        explicit xor_adaptor(list_type list);
+
+    public:
+        void push(const_reference val);
+        template <typename InputIt>
+        void push_n(InputIt first, size_type n);
+        void push_list(list_type &batch);
+
+        void pop();
+        bool try_pop(reference out);
+        template <typename OutputIt>
+        OutputIt drain_into(OutputIt out);
+
+        size_type size() const;
+        bool empty() const;
+        void clear();
+
+    protected:
+        reference next();
+        const_reference next() const;
+        list_type take_n(size_type n);
+
+    protected:
+        list_type m_list;
+    };
+}
+#include "xor_adaptor.hpp"
+#endif
@@ -0,0 +1,126 @@
+#ifndef XOR_XOR_ADAPTOR_HPP
+#define XOR_XOR_ADAPTOR_HPP
+#include "xor_adaptor.h"
+
+namespace my_std
+{
+    template <typename T, typename allocator, bool lifo>
+    xor_adaptor<T, allocator, lifo>::xor_adaptor(list_type list) : m_list(std::move(list)) {}
+
+    template <typename T, typename allocator, bool lifo>
+    void xor_adaptor<T, allocator, lifo>::push(const_reference val)
+    {
+        m_list.push_back(val);
+    }
+
+    template <typename T, typename allocator, bool lifo>
+    template <typename InputIt>
+    void xor_adaptor<T, allocator, lifo>::push_n(InputIt first, size_type n)
+    {
+        for (; n > 0; --n, ++first)
+        {
+            m_list.push_back(*first);
+        }
+    }
+
+    template <typename T, typename allocator, bool lifo>
+    void xor_adaptor<T, allocator, lifo>::push_list(list_type &batch)
+    {
+        m_list.splice_back(batch);
+    }
+
+    template <typename T, typename allocator, bool lifo>
+    void xor_adaptor<T, allocator, lifo>::pop()
+    {
+        if constexpr (lifo)
+        {
+            m_list.pop_back();
+        }
+        else
+        {
+            m_list.pop_front();
+        }
+    }
+
+    template <typename T, typename allocator, bool lifo>
+    bool xor_adaptor<T, allocator, lifo>::try_pop(reference out)
+    {
+        if (m_list.empty())
+        {
+            return false;
+        }
+        out = std::move(next());
+        pop();
+        return true;
+    }
+
+    template <typename T, typename allocator, bool lifo>
+    template <typename OutputIt>
+    OutputIt xor_adaptor<T, allocator, lifo>::drain_into(OutputIt out)
+    {
+        auto move_out = [&out](auto &&range)
+        {
+            for (auto &elem : range)
+            {
+                *out = std::move(elem);
+                ++out;
+            }
+        };
+        if constexpr (lifo)
+        {
+            move_out(m_list.reversed());
+        }
+        else
+        {
+            move_out(m_list);
+        }
+        m_list.clear();
+        return out;
+    }
+
+    template <typename T, typename allocator, bool lifo>
+    typename xor_adaptor<T, allocator, lifo>::size_type xor_adaptor<T, allocator, lifo>::size() const
+    {
+        return m_list.size();
+    }
+
+    template <typename T, typename allocator, bool lifo>
+    bool xor_adaptor<T, allocator, lifo>::empty() const
+    {
+        return m_list.empty();
+    }
+
+    template <typename T, typename allocator, bool lifo>
+    void xor_adaptor<T, allocator, lifo>::clear()
+    {
+        m_list.clear();
+    }
+
+    template <typename T, typename allocator, bool lifo>
+    typename xor_adaptor<T, allocator, lifo>::reference xor_adaptor<T, allocator, lifo>::next()
+    {
+        return lifo ? m_list.back() : m_list.front();
+    }
+
+    template <typename T, typename allocator, bool lifo>
+    typename xor_adaptor<T, allocator, lifo>::const_reference xor_adaptor<T, allocator, lifo>::next() const
+    {
+        return lifo ? m_list.back() : m_list.front();
+    }
+
+    template <typename T, typename allocator, bool lifo>
+    typename xor_adaptor<T, allocator, lifo>::list_type xor_adaptor<T, allocator, lifo>::take_n(size_type n)
+    {
+        if constexpr (lifo)
+        {
+            list_type result = m_list.split_back(n);
+            result.reverse();
+            return result;
+        }
+        else
+        {
+            return m_list.split_front(n);
+        }
+    }
+}
+#endif
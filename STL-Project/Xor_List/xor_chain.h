@@ -0,0 +1,27 @@
+#ifndef XOR_XOR_CHAIN_H
+#define XOR_XOR_CHAIN_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace my_std
+{
+    // Relinking primitives shared by the lists whose nodes carry an
+    // m_next_prev field holding prev ^ next. A chain is a (head, tail) pair
+    // of such nodes with null ends; nothing here allocates or touches the
+    // elements, and ordering goes through a predicate on nodes.
+    template <typename Node>
+    struct xor_chain
+    {
+        static Node *XOR(Node *first, Node *second);
+        static void link_back(Node *&head, Node *&tail, Node *node);
+        static Node *detach_front(Node *&head, Node *&tail);
+        static void append(Node *&head, Node *&tail, Node *other_head, Node *other_tail);
+        template <typename NodeLess>
+        static void merge(Node *&head, Node *&tail, Node *left_head, Node *left_tail, Node *right_head, Node *right_tail, NodeLess less);
+        template <typename NodeLess>
+        static void sort(Node *&head, Node *&tail, std::size_t count, NodeLess less);
+    };
+}
+#include "xor_chain.hpp"
+#endif
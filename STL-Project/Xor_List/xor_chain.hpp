@@ -0,0 +1,116 @@
+#ifndef XOR_XOR_CHAIN_HPP
+#define XOR_XOR_CHAIN_HPP
+#include "xor_chain.h"
+
+namespace my_std
+{
+    template <typename Node>
+    Node *xor_chain<Node>::XOR(Node *first, Node *second)
+    {
+        return reinterpret_cast<Node *>(reinterpret_cast<std::uintptr_t>(first) ^ reinterpret_cast<std::uintptr_t>(second));
+    }
+
+    template <typename Node>
+    void xor_chain<Node>::link_back(Node *&head, Node *&tail, Node *node)
+    {
+        node->m_next_prev = tail;
+        if (tail)
+        {
+            tail->m_next_prev = XOR(tail->m_next_prev, node);
+        }
+        else
+        {
+            head = node;
+        }
+        tail = node;
+    }
+
+    template <typename Node>
+    Node *xor_chain<Node>::detach_front(Node *&head, Node *&tail)
+    {
+        Node *node = head;
+        Node *next = node->m_next_prev;
+        if (next)
+        {
+            next->m_next_prev = XOR(next->m_next_prev, node);
+        }
+        else
+        {
+            tail = nullptr;
+        }
+        head = next;
+        return node;
+    }
+
+    template <typename Node>
+    void xor_chain<Node>::append(Node *&head, Node *&tail, Node *other_head, Node *other_tail)
+    {
+        if (!other_head)
+        {
+            return;
+        }
+        if (!tail)
+        {
+            head = other_head;
+        }
+        else
+        {
+            tail->m_next_prev = XOR(tail->m_next_prev, other_head);
+            other_head->m_next_prev = XOR(other_head->m_next_prev, tail);
+        }
+        tail = other_tail;
+    }
+
+    // Stable: on ties the left chain's node goes first.
+    template <typename Node>
+    template <typename NodeLess>
+    void xor_chain<Node>::merge(Node *&head, Node *&tail, Node *left_head, Node *left_tail, Node *right_head, Node *right_tail, NodeLess less)
+    {
+        head = nullptr;
+        tail = nullptr;
+        while (left_head && right_head)
+        {
+            if (less(right_head, left_head))
+            {
+                link_back(head, tail, detach_front(right_head, right_tail));
+            }
+            else
+            {
+                link_back(head, tail, detach_front(left_head, left_tail));
+            }
+        }
+        append(head, tail, left_head, left_tail);
+        append(head, tail, right_head, right_tail);
+    }
+
+    template <typename Node>
+    template <typename NodeLess>
+    void xor_chain<Node>::sort(Node *&head, Node *&tail, std::size_t count, NodeLess less)
+    {
+        if (count < 2)
+        {
+            return;
+        }
+
+        std::size_t half = count / 2;
+        Node *prev = nullptr;
+        Node *current = head;
+        for (std::size_t i = 0; i < half; ++i)
+        {
+            Node *next = XOR(prev, current->m_next_prev);
+            prev = current;
+            current = next;
+        }
+        prev->m_next_prev = XOR(prev->m_next_prev, current);
+        current->m_next_prev = XOR(current->m_next_prev, prev);
+
+        Node *left_head = head;
+        Node *left_tail = prev;
+        Node *right_head = current;
+        Node *right_tail = tail;
+        sort(left_head, left_tail, half, less);
+        sort(right_head, right_tail, count - half, less);
+        merge(head, tail, left_head, left_tail, right_head, right_tail, less);
+    }
+}
+#endif
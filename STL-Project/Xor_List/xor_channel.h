@@ -0,0 +1,107 @@
+#ifndef XOR_XOR_CHANNEL_H
+#define XOR_XOR_CHANNEL_H
+
+#include <mutex>
+#include <condition_variable>
+#include <coroutine>
+#include "xor_list.h"
+
+namespace my_std
+{
+    // Producers hand over whole xor_list batches, consumers take every pending
+    // element at once; both are O(1) relinks, so the mutex is taken once per
+    // batch rather than once per element. The capacity counts elements; a batch
+    // larger than the capacity is still accepted when the channel is empty.
+    template <typename T, typename allocator = Allocator<T>>
+    class xor_channel
+    {
+    public:
+        class send_awaiter;
+        class receive_awaiter;
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using const_reference = const T &;
+        using list_type = xor_list<T, allocator>;
+
+    public:
+        explicit xor_channel(size_type capacity);
+        xor_channel(const xor_channel &) = delete;
+        xor_channel &operator=(const xor_channel &) = delete;
+
+    public:
+        void send(list_type &batch);
+        void send(const_reference val);
+        bool try_send(list_type &batch);
+        list_type receive();
+        bool try_receive(list_type &out);
+
+        send_awaiter async_send(list_type batch);
+        receive_awaiter async_receive();
+
+        void close();
+        bool closed() const;
+        size_type size() const;
+        size_type capacity() const;
+
+    private:
+        bool fits(const list_type &batch) const;
+        void deliver(list_type &batch, receive_awaiter *&served);
+        void take_pending(list_type &out, send_awaiter *&admitted, receive_awaiter *&served);
+        static void resume_all(send_awaiter *admitted, receive_awaiter *served);
+
+    private:
+        list_type m_pending;
+        size_type m_capacity;
+        bool m_closed = false;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_not_empty;
+        std::condition_variable m_not_full;
+        send_awaiter *m_send_head = nullptr;
+        send_awaiter *m_send_tail = nullptr;
+        receive_awaiter *m_receive_head = nullptr;
+        receive_awaiter *m_receive_tail = nullptr;
+    };
+
+    template <typename T, typename allocator>
+    class xor_channel<T, allocator>::send_awaiter
+    {
+        friend class xor_channel<T, allocator>;
+
+    public:
+        bool await_ready() const noexcept;
+        bool await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const;
+
+    private:
+        send_awaiter(xor_channel *channel, list_type batch);
+
+        xor_channel *m_channel;
+        list_type m_batch;
+        std::coroutine_handle<> m_handle;
+        send_awaiter *m_next = nullptr;
+        bool m_closed = false;
+    };
+
+    template <typename T, typename allocator>
+    class xor_channel<T, allocator>::receive_awaiter
+    {
+        friend class xor_channel<T, allocator>;
+
+    public:
+        bool await_ready() const noexcept;
+        bool await_suspend(std::coroutine_handle<> handle);
+        list_type await_resume();
+
+    private:
+        explicit receive_awaiter(xor_channel *channel);
+
+        xor_channel *m_channel;
+        list_type m_result;
+        std::coroutine_handle<> m_handle;
+        receive_awaiter *m_next = nullptr;
+    };
+}
+#include "xor_channel.hpp"
+#endif
@@ -0,0 +1,301 @@
+#ifndef XOR_XOR_CHANNEL_HPP
+#define XOR_XOR_CHANNEL_HPP
+#include "xor_channel.h"
+
+namespace my_std
+{
+    template <typename T, typename allocator>
+    xor_channel<T, allocator>::xor_channel(size_type capacity) : m_capacity(capacity) {}
+
+    template <typename T, typename allocator>
+    void xor_channel<T, allocator>::send(list_type &batch)
+    {
+        receive_awaiter *served = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_not_full.wait(lock, [&]
+                            { return m_closed || (!m_send_head && fits(batch)); });
+            if (m_closed)
+            {
+                throw std::logic_error("Channel is closed");
+            }
+            deliver(batch, served);
+        }
+        resume_all(nullptr, served);
+    }
+
+    template <typename T, typename allocator>
+    void xor_channel<T, allocator>::send(const_reference val)
+    {
+        list_type batch;
+        batch.push_back(val);
+        send(batch);
+    }
+
+    template <typename T, typename allocator>
+    bool xor_channel<T, allocator>::try_send(list_type &batch)
+    {
+        receive_awaiter *served = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_closed || m_send_head || !fits(batch))
+            {
+                return false;
+            }
+            deliver(batch, served);
+        }
+        resume_all(nullptr, served);
+        return true;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_channel<T, allocator>::list_type xor_channel<T, allocator>::receive()
+    {
+        list_type out;
+        send_awaiter *admitted = nullptr;
+        receive_awaiter *served = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_not_empty.wait(lock, [&]
+                             { return m_closed || !m_pending.empty(); });
+            take_pending(out, admitted, served);
+        }
+        resume_all(admitted, served);
+        return out;
+    }
+
+    template <typename T, typename allocator>
+    bool xor_channel<T, allocator>::try_receive(list_type &out)
+    {
+        send_awaiter *admitted = nullptr;
+        receive_awaiter *served = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_pending.empty())
+            {
+                return false;
+            }
+            take_pending(out, admitted, served);
+        }
+        resume_all(admitted, served);
+        return true;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_channel<T, allocator>::send_awaiter xor_channel<T, allocator>::async_send(list_type batch)
+    {
+        return send_awaiter(this, std::move(batch));
+    }
+
+    template <typename T, typename allocator>
+    typename xor_channel<T, allocator>::receive_awaiter xor_channel<T, allocator>::async_receive()
+    {
+        return receive_awaiter(this);
+    }
+
+    template <typename T, typename allocator>
+    void xor_channel<T, allocator>::close()
+    {
+        send_awaiter *admitted = nullptr;
+        receive_awaiter *served = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+            for (send_awaiter *waiter = m_send_head; waiter; waiter = waiter->m_next)
+            {
+                waiter->m_closed = true;
+            }
+            admitted = m_send_head;
+            served = m_receive_head;
+            m_send_head = m_send_tail = nullptr;
+            m_receive_head = m_receive_tail = nullptr;
+        }
+        m_not_empty.notify_all();
+        m_not_full.notify_all();
+        resume_all(admitted, served);
+    }
+
+    template <typename T, typename allocator>
+    bool xor_channel<T, allocator>::closed() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_closed;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_channel<T, allocator>::size_type xor_channel<T, allocator>::size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pending.size();
+    }
+
+    template <typename T, typename allocator>
+    typename xor_channel<T, allocator>::size_type xor_channel<T, allocator>::capacity() const
+    {
+        return m_capacity;
+    }
+
+    template <typename T, typename allocator>
+    bool xor_channel<T, allocator>::fits(const list_type &batch) const
+    {
+        return m_pending.empty() || m_pending.size() + batch.size() <= m_capacity;
+    }
+
+    template <typename T, typename allocator>
+    void xor_channel<T, allocator>::deliver(list_type &batch, receive_awaiter *&served)
+    {
+        if (m_receive_head)
+        {
+            receive_awaiter *waiter = m_receive_head;
+            m_receive_head = waiter->m_next;
+            if (!m_receive_head)
+            {
+                m_receive_tail = nullptr;
+            }
+            waiter->m_result.splice_back(batch);
+            waiter->m_next = served;
+            served = waiter;
+            return;
+        }
+
+        m_pending.splice_back(batch);
+        m_not_empty.notify_one();
+    }
+
+    template <typename T, typename allocator>
+    void xor_channel<T, allocator>::take_pending(list_type &out, send_awaiter *&admitted, receive_awaiter *&served)
+    {
+        out.splice_back(m_pending);
+
+        while (m_send_head && fits(m_send_head->m_batch))
+        {
+            send_awaiter *waiter = m_send_head;
+            m_send_head = waiter->m_next;
+            if (!m_send_head)
+            {
+                m_send_tail = nullptr;
+            }
+            deliver(waiter->m_batch, served);
+            waiter->m_next = admitted;
+            admitted = waiter;
+        }
+        m_not_full.notify_all();
+    }
+
+    template <typename T, typename allocator>
+    void xor_channel<T, allocator>::resume_all(send_awaiter *admitted, receive_awaiter *served)
+    {
+        while (admitted)
+        {
+            send_awaiter *next = admitted->m_next;
+            admitted->m_handle.resume();
+            admitted = next;
+        }
+        while (served)
+        {
+            receive_awaiter *next = served->m_next;
+            served->m_handle.resume();
+            served = next;
+        }
+    }
+
+    // =====================================send awaiter ============================================
+
+    template <typename T, typename allocator>
+    xor_channel<T, allocator>::send_awaiter::send_awaiter(xor_channel *channel, list_type batch) : m_channel(channel), m_batch(std::move(batch)) {}
+
+    template <typename T, typename allocator>
+    bool xor_channel<T, allocator>::send_awaiter::await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <typename T, typename allocator>
+    bool xor_channel<T, allocator>::send_awaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        m_handle = handle;
+        receive_awaiter *served = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_channel->m_mutex);
+            if (m_channel->m_closed)
+            {
+                m_closed = true;
+                return false;
+            }
+            if (m_channel->m_send_head || !m_channel->fits(m_batch))
+            {
+                if (m_channel->m_send_tail)
+                {
+                    m_channel->m_send_tail->m_next = this;
+                }
+                else
+                {
+                    m_channel->m_send_head = this;
+                }
+                m_channel->m_send_tail = this;
+                return true;
+            }
+            m_channel->deliver(m_batch, served);
+        }
+        resume_all(nullptr, served);
+        return false;
+    }
+
+    template <typename T, typename allocator>
+    void xor_channel<T, allocator>::send_awaiter::await_resume() const
+    {
+        if (m_closed)
+        {
+            throw std::logic_error("Channel is closed");
+        }
+    }
+
+    // =====================================receive awaiter ============================================
+
+    template <typename T, typename allocator>
+    xor_channel<T, allocator>::receive_awaiter::receive_awaiter(xor_channel *channel) : m_channel(channel) {}
+
+    template <typename T, typename allocator>
+    bool xor_channel<T, allocator>::receive_awaiter::await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <typename T, typename allocator>
+    bool xor_channel<T, allocator>::receive_awaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        m_handle = handle;
+        send_awaiter *admitted = nullptr;
+        receive_awaiter *served = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_channel->m_mutex);
+            if (m_channel->m_pending.empty())
+            {
+                if (m_channel->m_closed)
+                {
+                    return false;
+                }
+                if (m_channel->m_receive_tail)
+                {
+                    m_channel->m_receive_tail->m_next = this;
+                }
+                else
+                {
+                    m_channel->m_receive_head = this;
+                }
+                m_channel->m_receive_tail = this;
+                return true;
+            }
+            m_channel->take_pending(m_result, admitted, served);
+        }
+        resume_all(admitted, served);
+        return false;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_channel<T, allocator>::list_type xor_channel<T, allocator>::receive_awaiter::await_resume()
+    {
+        return std::move(m_result);
+    }
+}
+#endif
@@ -9,6 +9,20 @@
 #include <initializer_list>
 #include <new>
 #include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <span>
+#include <iterator>
+#include <bit>
+#include <type_traits>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <cstdio>
+#include <cstring>
+#include "xor_chain.h"
 
 namespace my_std
 {
@@ -16,19 +30,55 @@ namespace my_std
     class Allocator
     {
     public:
+        template <typename U>
+        struct rebind
+        {
+            using other = Allocator<U>;
+        };
+
+    public:
+        Allocator() = default;
+        template <typename U>
+        Allocator(const Allocator<U> &rhv);
+
         T *allocate();
         template <typename... Args>
         void construct(T *ptr, Args &&...args);
         void destroy(T *ptr);
         void deallocate(T *ptr);
+
+        template <typename U>
+        bool operator==(const Allocator<U> &rhv) const;
     };
 
     template <typename T, typename allocator = Allocator<T>>
+    class xor_list;
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    class xor_lru_cache;
+
+    template <typename T, std::size_t N>
+    class small_xor_list;
+
+    struct xor_list_parallel;
+
+    // Relinks the nodes of every list into one sorted list. All lists must
+    // use equal allocators; otherwise std::logic_error is thrown and no list
+    // is modified.
+    template <typename T, typename allocator, typename Compare = std::less<>>
+    xor_list<T, allocator> merge_k(std::span<xor_list<T, allocator> *> lists, Compare comp = Compare());
+
+    template <typename T, typename allocator>
     class xor_list
     {
     public:
         class iterator;
         class const_iterator;
+        class reverse_iterator;
+        class const_reverse_iterator;
+        class cursor;
+        template <typename iter>
+        class range;
 
     public:
         using value_type = T;
@@ -39,12 +89,41 @@ namespace my_std
         using difference_type = std::ptrdiff_t;
         using reference = T &;
         using const_reference = const T &;
-        struct Node
+        struct Node;
+        // XOR'd neighbour addresses with the node's flags in the low three
+        // bits, which Node's alignment leaves free: bit 0 marks a tombstone
+        // and bits 1-2 name the packed chunk class defragment() put the node
+        // in. Reading yields the bare link and assigning a link keeps the
+        // flags, so they cost no extra field and travel with the node.
+        class Link
+        {
+        public:
+            Link(Node *link = nullptr);
+            Link(const Link &) = default;
+            Link &operator=(const Link &rhv);
+            Link &operator=(Node *link);
+            operator Node *() const;
+            bool erased() const;
+            void mark_erased();
+            unsigned chunk_class() const;
+            void set_chunk_class(unsigned chunk_class);
+
+        private:
+            static constexpr std::uintptr_t erased_bit = 1;
+            static constexpr std::uintptr_t chunk_shift = 1;
+            static constexpr std::uintptr_t chunk_bits = std::uintptr_t(3) << chunk_shift;
+            static constexpr std::uintptr_t flag_mask = erased_bit | chunk_bits;
+
+            std::uintptr_t m_bits;
+        };
+        struct alignas(8) Node
         {
             T m_data;
-            Node *m_next_prev;
+            Link m_next_prev;
             Node(T val);
         };
+        using node_allocator = typename allocator::template rebind<Node>::other;
+        using chain = xor_chain<Node>;
 
     public:
         xor_list();
@@ -53,7 +132,7 @@ namespace my_std
         xor_list(const xor_list &rhv);
         xor_list(const xor_list &rhv, const allocator &aloc);
         xor_list(xor_list &&rhv) noexcept;
-        xor_list(xor_list &&rhv, const allocator &aloc) noexcept;
+        xor_list(xor_list &&rhv, const allocator &aloc);
         explicit xor_list(size_type count);
         explicit xor_list(size_type count, const allocator &aloc = allocator());
         xor_list(size_type count, const_reference init);
@@ -68,16 +147,28 @@ namespace my_std
         void assign(std::initializer_list<value_type> init);
 
     public:
+        allocator_type get_allocator() const;
         void swap(xor_list &rhv);
         bool empty() const;
         void resize(size_type s, const_reference init = value_type());
         void clear() noexcept;
+        bool clear_incremental(size_type budget);
         void print() const;
         void push_back(const_reference val);
+        void push_back(value_type &&val);
         void push_front(const_reference val);
         void pop_back();
         void pop_front();
         size_type size() const;
+        iterator mark_erased(iterator pos);
+        void compact();
+        double compaction_ratio() const;
+        void set_compaction_ratio(double ratio);
+        // Relocates nodes into chunks from std::aligned_alloc in list order.
+        // Only lists on the default Allocator can be defragmented, since the
+        // allocator interface hands out one node at a time.
+        void defragment();
+        iterator defragment(iterator from, size_type budget);
         const_reference front() const;
         reference front();
         const_reference back() const;
@@ -91,11 +182,23 @@ namespace my_std
 
     public:
         bool operator==(const xor_list &rhv) const;
+        template <typename U = T>
+        std::compare_three_way_result_t<U> operator<=>(const xor_list &rhv) const;
         iterator begin();
+        const_iterator begin() const;
         const_iterator cbegin() const;
 
         iterator end();
+        const_iterator end() const;
         const_iterator cend() const;
+        reverse_iterator rbegin();
+        const_reverse_iterator rbegin() const;
+        reverse_iterator rend();
+        const_reverse_iterator rend() const;
+        const_reverse_iterator crbegin() const;
+        const_reverse_iterator crend() const;
+        range<reverse_iterator> reversed();
+        range<const_reverse_iterator> reversed() const;
         iterator insert(iterator pos, value_type val);
         iterator insert(iterator pos, size_type size, const_reference val);
         iterator insert(iterator pos, std::initializer_list<value_type> init);
@@ -104,45 +207,122 @@ namespace my_std
         iterator insert_rev(iterator pos , const_reference val);
         iterator erase(iterator pos);
         iterator erase(iterator f, iterator l);
+        cursor begin_cursor();
+        cursor end_cursor();
+        cursor cursor_at(iterator pos);
         size_type remove(const_reference val);
         void reverse();
         void sort();
+        template <typename KeyFn>
+        void sort_by_key(KeyFn key);
 
+        // splice_back, merge and partition_into relink nodes between lists and
+        // throw std::logic_error when the two allocators compare unequal.
+        void splice_back(xor_list &other);
+        xor_list split_front(size_type count);
+        xor_list split_back(size_type count);
         void merge(xor_list &other);
+        void merge(xor_list &&other);
+        template <typename Compare>
+        void merge(xor_list &other, Compare comp);
+        template <typename Compare>
+        void merge(xor_list &&other, Compare comp);
+        template <typename Pred>
+        iterator partition(Pred pred);
+        template <typename Pred>
+        iterator stable_partition(Pred pred);
+        template <typename Pred>
+        size_type partition_into(Pred pred, xor_list &out);
+        iterator nth_element(size_type n);
+        template <typename Compare>
+        iterator nth_element(size_type n, Compare comp);
+        void partial_sort(size_type k);
+        template <typename Compare>
+        void partial_sort(size_type k, Compare comp);
+        size_type parse_from(std::string_view text);
+        size_type load_text(const std::string &path);
+        template <typename Consumer>
+        static size_type stream_text(const std::string &path, size_type chunk, Consumer consume, const allocator &aloc = allocator());
         void unique();
         iterator find(const_reference elem);
         iterator rfind(const_reference elem);
 
+    private:
+        template <typename U, typename A, typename Compare>
+        friend xor_list<U, A> merge_k(std::span<xor_list<U, A> *> lists, Compare comp);
+        template <typename K, typename V, typename Hash, typename KeyEqual>
+        friend class xor_lru_cache;
+        template <typename U, std::size_t N>
+        friend class small_xor_list;
+        friend struct xor_list_parallel;
+
+        void require_same_allocator(const xor_list &other) const;
+        void free_node(Node *node);
+        std::size_t parse_prefix(std::string_view text, bool final);
+        template <typename BlockFn>
+        static void read_blocks(const std::string &path, BlockFn on_block);
+        void advance(Node *&prev, Node *&current) const;
+        void link_between(Node *prev, Node *next, Node *node);
+        void unlink_node(Node *&prev, Node *&node);
+        template <typename Compare>
+        void sort_chain(Node *&head, Node *&tail, size_type count, Compare comp);
+
+        struct PackedChunk
+        {
+            size_type m_live;
+        };
+        static constexpr size_type packed_header = (sizeof(PackedChunk) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+        static constexpr unsigned packed_classes = 3;
+        static constexpr bool packs_nodes = std::is_same_v<allocator, Allocator<T>>;
+        static constexpr size_type packed_chunk_size(unsigned chunk_class);
+        static constexpr size_type packed_capacity(unsigned chunk_class);
+        static PackedChunk *new_packed_chunk(unsigned chunk_class);
+        static void free_packed_chunk(PackedChunk *chunk);
+        static void release_packed_chunk(PackedChunk *chunk);
+
     private:
         Node *m_head;
         Node *m_tail;
-        Allocator<Node> m_allocator;
+        node_allocator m_allocator;
+        size_type m_size = 0;
+        size_type m_tombstones = 0;
+        double m_compaction_ratio = 0.0;
     };
 
     template <typename T, typename allocator>
     class xor_list<T, allocator>::const_iterator
     {
         friend class xor_list<T, allocator>;
+        friend struct xor_list_parallel;
+        friend class const_reverse_iterator;
 
     public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+    public:
+        const_iterator();
         const_iterator(const const_iterator &rhv);
         const_iterator(const_iterator &&rhv);
 
-        const const_iterator &operator=(const const_iterator &rhv);
-        const const_iterator &operator=(const_iterator &&rhv);
+        const_iterator &operator=(const const_iterator &rhv);
+        const_iterator &operator=(const_iterator &&rhv);
         const_reference operator*() const;
         const_pointer operator->() const;
 
-        const const_iterator &operator++();
-        const const_iterator operator++(value_type);
-        const const_iterator &operator--();
-        const const_iterator operator--(value_type);
+        const_iterator &operator++();
+        const_iterator operator++(int);
+        const_iterator &operator--();
+        const_iterator operator--(int);
 
         bool operator==(const const_iterator &rhv) const;
         bool operator!=(const const_iterator &rhv) const;
 
     protected:
-        explicit const_iterator(Node *ptr, Node *ptr2);
+        explicit const_iterator(Node *prev, Node *ptr);
         Node *ptr;
         Node *next;
         Node *prev;
@@ -152,19 +332,153 @@ namespace my_std
     class xor_list<T, allocator>::iterator : public xor_list<T, allocator>::const_iterator
     {
         friend class xor_list<T, allocator>;
+        friend struct xor_list_parallel;
+        friend class reverse_iterator;
+
+    public:
+        using pointer = T *;
+        using reference = T &;
 
     public:
+        iterator();
         iterator(const iterator &rhv);
         iterator(iterator &&rhv);
 
-        reference operator*();
-        pointer_type operator->();
+        reference operator*() const;
+        pointer operator->() const;
 
-        const iterator &operator=(const iterator &rhv);
-        const iterator &operator=(iterator &&rhv);
+        iterator &operator=(const iterator &rhv);
+        iterator &operator=(iterator &&rhv);
+
+        iterator &operator++();
+        iterator operator++(int);
+        iterator &operator--();
+        iterator operator--(int);
 
     protected:
-        explicit iterator(Node *ptr1, Node *ptr2);
+        explicit iterator(Node *prev, Node *ptr);
+    };
+
+    // Like std::reverse_iterator, the reverse iterators wrap a forward
+    // iterator privately and do not convert to one, so they cannot be passed
+    // to insert or erase by mistake; base() gives the forward position. The
+    // wrapped iterator starts from the tail, and since XOR links have no
+    // direction, stepping it forward walks the list backwards.
+    template <typename T, typename allocator>
+    class xor_list<T, allocator>::const_reverse_iterator
+    {
+        friend class xor_list<T, allocator>;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+    public:
+        const_reverse_iterator() = default;
+        const_reverse_iterator(const reverse_iterator &rhv);
+
+        const_iterator base() const;
+        reference operator*() const;
+        pointer operator->() const;
+
+        const_reverse_iterator &operator++();
+        const_reverse_iterator operator++(int);
+        const_reverse_iterator &operator--();
+        const_reverse_iterator operator--(int);
+
+        bool operator==(const const_reverse_iterator &rhv) const;
+        bool operator!=(const const_reverse_iterator &rhv) const;
+
+    private:
+        explicit const_reverse_iterator(const_iterator it);
+
+        const_iterator m_it;
+    };
+
+    template <typename T, typename allocator>
+    class xor_list<T, allocator>::reverse_iterator
+    {
+        friend class xor_list<T, allocator>;
+        friend class const_reverse_iterator;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+
+    public:
+        reverse_iterator() = default;
+
+        iterator base() const;
+        reference operator*() const;
+        pointer operator->() const;
+
+        reverse_iterator &operator++();
+        reverse_iterator operator++(int);
+        reverse_iterator &operator--();
+        reverse_iterator operator--(int);
+
+        bool operator==(const reverse_iterator &rhv) const;
+        bool operator!=(const reverse_iterator &rhv) const;
+
+    private:
+        explicit reverse_iterator(iterator it);
+
+        iterator m_it;
+    };
+
+    template <typename T, typename allocator>
+    class xor_list<T, allocator>::cursor
+    {
+        friend class xor_list<T, allocator>;
+
+    public:
+        reference operator*() const;
+        pointer_type operator->() const;
+
+        bool at_begin() const;
+        bool at_end() const;
+        bool move_next();
+        bool move_prev();
+
+        void insert_before(const_reference val);
+        void insert_after(const_reference val);
+        void erase_current();
+        iterator position() const;
+
+    private:
+        cursor(xor_list *list, Node *prev, Node *current);
+
+        xor_list *m_list;
+        Node *m_prev;
+        Node *m_current;
+    };
+
+    template <typename T, typename allocator>
+    template <typename iter>
+    class xor_list<T, allocator>::range
+    {
+    public:
+        range(iter first, iter last);
+        iter begin() const;
+        iter end() const;
+
+    private:
+        iter m_first;
+        iter m_last;
+    };
+}
+namespace std
+{
+    template <typename T, typename allocator>
+    struct hash<my_std::xor_list<T, allocator>>
+    {
+        size_t operator()(const my_std::xor_list<T, allocator> &list) const;
     };
 }
 #include "xor_list.hpp"
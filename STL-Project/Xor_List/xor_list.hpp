@@ -5,6 +5,17 @@
 namespace my_std
 {
 
+    template <typename T>
+    template <typename U>
+    Allocator<T>::Allocator(const Allocator<U> &) {}
+
+    template <typename T>
+    template <typename U>
+    bool Allocator<T>::operator==(const Allocator<U> &) const
+    {
+        return true;
+    }
+
     template <typename T>
     T *Allocator<T>::allocate()
     {
@@ -31,7 +42,53 @@ namespace my_std
     }
 
     template <typename T, typename allocator>
-    xor_list<T, allocator>::Node::Node(T val) : m_data(val), m_next_prev(nullptr) {}
+    xor_list<T, allocator>::Link::Link(Node *link) : m_bits(reinterpret_cast<std::uintptr_t>(link)) {}
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::Link &xor_list<T, allocator>::Link::operator=(const Link &rhv)
+    {
+        return *this = static_cast<Node *>(rhv);
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::Link &xor_list<T, allocator>::Link::operator=(Node *link)
+    {
+        m_bits = reinterpret_cast<std::uintptr_t>(link) | (m_bits & flag_mask);
+        return *this;
+    }
+
+    template <typename T, typename allocator>
+    xor_list<T, allocator>::Link::operator Node *() const
+    {
+        return reinterpret_cast<Node *>(m_bits & ~flag_mask);
+    }
+
+    template <typename T, typename allocator>
+    bool xor_list<T, allocator>::Link::erased() const
+    {
+        return m_bits & erased_bit;
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::Link::mark_erased()
+    {
+        m_bits |= erased_bit;
+    }
+
+    template <typename T, typename allocator>
+    unsigned xor_list<T, allocator>::Link::chunk_class() const
+    {
+        return static_cast<unsigned>((m_bits & chunk_bits) >> chunk_shift);
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::Link::set_chunk_class(unsigned chunk_class)
+    {
+        m_bits = (m_bits & ~chunk_bits) | (std::uintptr_t(chunk_class) << chunk_shift);
+    }
+
+    template <typename T, typename allocator>
+    xor_list<T, allocator>::Node::Node(T val) : m_data(std::move(val)), m_next_prev(nullptr) {}
 
     template <typename T, typename allocator>
     xor_list<T, allocator>::xor_list() : m_head(nullptr), m_tail(nullptr) {}
@@ -59,7 +116,7 @@ namespace my_std
     }
 
     template <typename T, typename allocator>
-    xor_list<T, allocator>::xor_list(std::initializer_list<value_type> init, const allocator &aloc) : m_head(nullptr), m_tail(nullptr)
+    xor_list<T, allocator>::xor_list(std::initializer_list<value_type> init, const allocator &aloc) : m_head(nullptr), m_tail(nullptr), m_allocator(aloc)
     {
         for (const auto &elem : init)
         {
@@ -92,7 +149,7 @@ namespace my_std
     }
 
     template <typename T, typename allocator>
-    xor_list<T, allocator>::xor_list(const xor_list &rhv) : m_head(nullptr), m_tail(nullptr)
+    xor_list<T, allocator>::xor_list(const xor_list &rhv) : m_head(nullptr), m_tail(nullptr), m_allocator(rhv.m_allocator)
     {
         Node *current = rhv.m_head;
         Node *prev = nullptr;
@@ -100,20 +157,9 @@ namespace my_std
 
         while (current)
         {
-            Node *newNode = m_allocator.allocate();
-            new (newNode) Node(current->m_data);
-
-            if (!m_head)
-            {
-                m_head = newNode;
-                m_tail = newNode;
-                newNode->m_next_prev = nullptr;
-            }
-            else
+            if (!current->m_next_prev.erased())
             {
-                newNode->m_next_prev = XOR(m_tail, nullptr);
-                m_tail->m_next_prev = XOR(m_tail->m_next_prev, newNode);
-                m_tail = newNode;
+                push_back(current->m_data);
             }
 
             next = XOR(current->m_next_prev, prev);
@@ -131,20 +177,9 @@ namespace my_std
 
         while (current)
         {
-            Node *newNode = m_allocator.allocate();
-            new (newNode) Node(current->m_data);
-
-            if (!m_head)
-            {
-                m_head = newNode;
-                m_tail = newNode;
-                newNode->m_next_prev = nullptr;
-            }
-            else
+            if (!current->m_next_prev.erased())
             {
-                newNode->m_next_prev = XOR(m_tail, nullptr);
-                m_tail->m_next_prev = XOR(m_tail->m_next_prev, newNode);
-                m_tail = newNode;
+                push_back(current->m_data);
             }
 
             next = XOR(current->m_next_prev, prev);
@@ -154,17 +189,33 @@ namespace my_std
     }
 
     template <typename T, typename allocator>
-    xor_list<T, allocator>::xor_list(xor_list &&rhv) noexcept : m_head(rhv.m_head), m_tail(rhv.m_tail)
+    xor_list<T, allocator>::xor_list(xor_list &&rhv) noexcept : m_head(rhv.m_head), m_tail(rhv.m_tail), m_allocator(rhv.m_allocator), m_size(rhv.m_size), m_tombstones(rhv.m_tombstones), m_compaction_ratio(rhv.m_compaction_ratio)
     {
         rhv.m_head = nullptr;
         rhv.m_tail = nullptr;
+        rhv.m_size = 0;
+        rhv.m_tombstones = 0;
     }
 
     template <typename T, typename allocator>
-    xor_list<T, allocator>::xor_list(xor_list &&rhv, const allocator &aloc) noexcept : m_head(rhv.m_head), m_tail(rhv.m_tail)
+    xor_list<T, allocator>::xor_list(xor_list &&rhv, const allocator &aloc) : m_head(nullptr), m_tail(nullptr), m_allocator(aloc), m_compaction_ratio(rhv.m_compaction_ratio)
     {
-        rhv.m_head = nullptr;
-        rhv.m_tail = nullptr;
+        if (m_allocator == rhv.m_allocator)
+        {
+            m_head = std::exchange(rhv.m_head, nullptr);
+            m_tail = std::exchange(rhv.m_tail, nullptr);
+            m_size = std::exchange(rhv.m_size, 0);
+            m_tombstones = std::exchange(rhv.m_tombstones, 0);
+            return;
+        }
+
+        // Nodes owned by an unequal allocator cannot be adopted; move the
+        // elements into nodes from ours instead.
+        for (reference elem : rhv)
+        {
+            push_back(std::move(elem));
+        }
+        rhv.clear();
     }
 
     template <typename T, typename allocator>
@@ -181,20 +232,9 @@ namespace my_std
 
         while (current)
         {
-            Node *newNode = m_allocator.allocate();
-            new (newNode) Node(current->m_data);
-
-            if (!m_head)
-            {
-                m_head = newNode;
-                m_tail = newNode;
-                newNode->m_next_prev = nullptr;
-            }
-            else
+            if (!current->m_next_prev.erased())
             {
-                newNode->m_next_prev = XOR(m_tail, nullptr);
-                m_tail->m_next_prev = XOR(m_tail->m_next_prev, newNode);
-                m_tail = newNode;
+                push_back(current->m_data);
             }
 
             next = XOR(current->m_next_prev, prev);
@@ -212,12 +252,18 @@ namespace my_std
             return *this;
         }
 
+        clear();
         m_head = rhv.m_head;
         m_tail = rhv.m_tail;
         m_allocator = rhv.m_allocator;
+        m_size = rhv.m_size;
+        m_tombstones = rhv.m_tombstones;
+        m_compaction_ratio = rhv.m_compaction_ratio;
 
         rhv.m_head = nullptr;
         rhv.m_tail = nullptr;
+        rhv.m_size = 0;
+        rhv.m_tombstones = 0;
 
         return *this;
     }
@@ -249,31 +295,58 @@ namespace my_std
             m_tail->m_next_prev = XOR(new_node, XOR(m_tail->m_next_prev, nullptr));
             m_tail = new_node;
         }
+        ++m_size;
     }
 
     template <typename T, typename allocator>
-    void xor_list<T, allocator>::pop_back()
+    void xor_list<T, allocator>::push_back(value_type &&val)
     {
+        Node *new_node = m_allocator.allocate();
+        m_allocator.construct(new_node, std::move(val));
         if (!m_tail)
         {
-            throw std::logic_error("List is empty");
+            m_head = m_tail = new_node;
+        }
+        else
+        {
+            new_node->m_next_prev = XOR(nullptr, m_tail);
+            m_tail->m_next_prev = XOR(new_node, XOR(m_tail->m_next_prev, nullptr));
+            m_tail = new_node;
         }
-        else if (!m_head->m_next_prev)
+        ++m_size;
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::pop_back()
+    {
+        if (!m_tail)
         {
-            m_head->~Node();
-            m_allocator.deallocate(m_head);
-            m_head = m_tail = nullptr;
+            throw std::logic_error("List is empty");
         }
-        else
+
+        do
         {
-            Node *prev = XOR(nullptr, m_tail->m_next_prev);
-            prev->m_next_prev = XOR(nullptr, XOR(m_tail, prev->m_next_prev));
+            if (m_tail->m_next_prev.erased())
+            {
+                --m_tombstones;
+            }
+
+            if (!m_head->m_next_prev)
+            {
+                free_node(m_head);
+                m_head = m_tail = nullptr;
+            }
+            else
+            {
+                Node *prev = XOR(nullptr, m_tail->m_next_prev);
+                prev->m_next_prev = XOR(nullptr, XOR(m_tail, prev->m_next_prev));
 
-            m_allocator.destroy(m_tail);
-            m_allocator.deallocate(m_tail);
+                free_node(m_tail);
 
-            m_tail = prev;
-        }
+                m_tail = prev;
+            }
+            --m_size;
+        } while (m_tail && m_tail->m_next_prev.erased());
     }
 
     template <typename T, typename allocator>
@@ -282,6 +355,12 @@ namespace my_std
         return m_head == nullptr;
     }
 
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::allocator_type xor_list<T, allocator>::get_allocator() const
+    {
+        return allocator_type(m_allocator);
+    }
+
     template <typename T, typename allocator>
     void xor_list<T, allocator>::swap(xor_list &rhv)
     {
@@ -314,22 +393,30 @@ namespace my_std
         {
             throw std::logic_error("List is empty");
         }
-        else if (!m_head->m_next_prev)
-        {
-            m_head->~Node();
-            m_allocator.deallocate(m_head);
-            m_head = m_tail = nullptr;
-        }
-        else
+
+        do
         {
-            Node *next = XOR(nullptr, m_head->m_next_prev);
-            next->m_next_prev = XOR(nullptr, XOR(m_head, next->m_next_prev));
+            if (m_head->m_next_prev.erased())
+            {
+                --m_tombstones;
+            }
 
-            m_allocator.destroy(m_head);
-            m_allocator.deallocate(m_head);
+            if (!m_head->m_next_prev)
+            {
+                free_node(m_head);
+                m_head = m_tail = nullptr;
+            }
+            else
+            {
+                Node *next = XOR(nullptr, m_head->m_next_prev);
+                next->m_next_prev = XOR(nullptr, XOR(m_head, next->m_next_prev));
 
-            m_head = next;
-        }
+                free_node(m_head);
+
+                m_head = next;
+            }
+            --m_size;
+        } while (m_head && m_head->m_next_prev.erased());
     }
 
     template <typename T, typename allocator>
@@ -347,6 +434,7 @@ namespace my_std
             m_head->m_next_prev = XOR(new_node, XOR(m_head->m_next_prev, nullptr));
             m_head = new_node;
         }
+        ++m_size;
     }
 
     template <typename T, typename allocator>
@@ -357,7 +445,10 @@ namespace my_std
         Node *next;
         while (curr != nullptr)
         {
-            std::cout << curr->m_data << " ";
+            if (!curr->m_next_prev.erased())
+            {
+                std::cout << curr->m_data << " ";
+            }
             next = XOR(prev, curr->m_next_prev);
             prev = curr;
             curr = next;
@@ -369,6 +460,68 @@ namespace my_std
         std::cout << std::endl;
     }
 
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::free_node(Node *node)
+    {
+        if constexpr (packs_nodes)
+        {
+            if (unsigned chunk_class = node->m_next_prev.chunk_class())
+            {
+                std::uintptr_t mask = packed_chunk_size(chunk_class) - 1;
+                PackedChunk *chunk = reinterpret_cast<PackedChunk *>(reinterpret_cast<std::uintptr_t>(node) & ~mask);
+                node->~Node();
+                release_packed_chunk(chunk);
+                return;
+            }
+        }
+        m_allocator.destroy(node);
+        m_allocator.deallocate(node);
+    }
+
+    // Classes 1 to 3 are 4 KiB, 32 KiB and 256 KiB chunks aligned to their
+    // size, so a packed node finds its chunk by masking its own address.
+    template <typename T, typename allocator>
+    constexpr typename xor_list<T, allocator>::size_type xor_list<T, allocator>::packed_chunk_size(unsigned chunk_class)
+    {
+        return size_type(512) << (3 * chunk_class);
+    }
+
+    template <typename T, typename allocator>
+    constexpr typename xor_list<T, allocator>::size_type xor_list<T, allocator>::packed_capacity(unsigned chunk_class)
+    {
+        return packed_chunk_size(chunk_class) < packed_header ? 0 : (packed_chunk_size(chunk_class) - packed_header) / sizeof(Node);
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::PackedChunk *xor_list<T, allocator>::new_packed_chunk(unsigned chunk_class)
+    {
+        size_type bytes = packed_chunk_size(chunk_class);
+        void *raw = std::aligned_alloc(bytes, bytes);
+        if (!raw)
+        {
+            throw std::bad_alloc();
+        }
+        return ::new (raw) PackedChunk{0};
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::free_packed_chunk(PackedChunk *chunk)
+    {
+        chunk->~PackedChunk();
+        std::free(chunk);
+    }
+
+    // Drops one reference: a live node, or the parser's hold on the chunk
+    // it is still carving.
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::release_packed_chunk(PackedChunk *chunk)
+    {
+        if (chunk && --chunk->m_live == 0)
+        {
+            free_packed_chunk(chunk);
+        }
+    }
+
     template <typename T, typename allocator>
     typename xor_list<T, allocator>::Node *xor_list<T, allocator>::XOR(Node *first, Node *second) const
     {
@@ -384,30 +537,53 @@ namespace my_std
         while (current)
         {
             Node *next = XOR(current->m_next_prev, prev);
-            m_allocator.deallocate(current);
+            free_node(current);
             prev = current;
             current = next;
         }
 
         m_head = nullptr;
         m_tail = nullptr;
+        m_size = 0;
+        m_tombstones = 0;
     }
 
     template <typename T, typename allocator>
-    typename xor_list<T, allocator>::size_type xor_list<T, allocator>::size() const
+    bool xor_list<T, allocator>::clear_incremental(size_type budget)
     {
-        Node *current = m_head;
-        Node *prev = nullptr;
-
-        size_type count = 0;
-        while (current)
+        // Every freed node costs one unit, tombstones included. pop_front()
+        // would also free the tombstones after the head, so those are taken
+        // out from behind the head one at a time, which keeps it live.
+        for (; budget > 0 && m_head; --budget)
         {
-            ++count;
-            Node *next = XOR(current->m_next_prev, prev);
-            prev = current;
-            current = next;
+            Node *next = XOR(nullptr, m_head->m_next_prev);
+            if (!next || !next->m_next_prev.erased())
+            {
+                pop_front();
+                continue;
+            }
+
+            Node *after = XOR(m_head, next->m_next_prev);
+            m_head->m_next_prev = after;
+            if (after)
+            {
+                after->m_next_prev = XOR(XOR(after->m_next_prev, next), m_head);
+            }
+            else
+            {
+                m_tail = m_head;
+            }
+            free_node(next);
+            --m_size;
+            --m_tombstones;
         }
-        return count;
+        return m_head == nullptr;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::size_type xor_list<T, allocator>::size() const
+    {
+        return m_size - m_tombstones;
     }
 
     template <typename T, typename allocator>
@@ -450,130 +626,327 @@ namespace my_std
         return m_tail->m_data;
     }
 
-    // =====================================const iterator ============================================
-
-    template <typename T, typename allocator>
-    bool xor_list<T, allocator>::const_iterator::operator==(const const_iterator &rhv) const
-    {
-        return rhv.ptr == this->ptr;
-    }
-
     template <typename T, typename allocator>
-    bool xor_list<T, allocator>::const_iterator::operator!=(const const_iterator &rhv) const
+    typename xor_list<T, allocator>::iterator xor_list<T, allocator>::mark_erased(iterator pos)
     {
-        return rhv.ptr != this->ptr;
-    }
-
-    template <typename T, typename allocator>
-    xor_list<T, allocator>::const_iterator::const_iterator(const const_iterator &rhv) : ptr{rhv.ptr}, prev{rhv.prev}, next{rhv.next} {}
-
-    template <typename T, typename allocator>
-    xor_list<T, allocator>::const_iterator::const_iterator(const_iterator &&rhv) : ptr{rhv.ptr}, prev{rhv.prev}, next{rhv.next} {}
+        if (pos.ptr == nullptr || pos.ptr->m_next_prev.erased())
+        {
+            throw std::logic_error("Attempt to erase an invalid iterator");
+        }
 
-    template <typename T, typename allocator>
-    xor_list<T, allocator>::const_iterator::const_iterator(Node *ptr1, Node *ptr2)
-    {
-        if (!ptr2)
+        if (pos.ptr == m_head)
         {
-            ptr = ptr1;
-            prev = nullptr;
-            next = ptr ? reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(nullptr) ^ reinterpret_cast<uintptr_t>(ptr->m_next_prev)) : nullptr;
+            pop_front();
+            return begin();
         }
-        else
+        if (pos.ptr == m_tail)
         {
-            ptr = reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(ptr2) ^ reinterpret_cast<uintptr_t>(ptr1->m_next_prev));
-            prev = ptr1;
-            next = ptr ? reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(prev) ^ reinterpret_cast<uintptr_t>(ptr->m_next_prev)) : nullptr;
+            pop_back();
+            return end();
         }
-    }
 
-    template <typename T, typename allocator>
-    const typename xor_list<T, allocator>::const_iterator &xor_list<T, allocator>::const_iterator::operator=(const const_iterator &rhv)
-    {
-        ptr = rhv.ptr;
-        prev = rhv.prev;
-        next = rhv.next;
-        return *this;
-    }
+        pos.ptr->m_next_prev.mark_erased();
+        ++m_tombstones;
+        ++pos;
 
-    template <typename T, typename allocator>
-    const typename xor_list<T, allocator>::const_iterator &xor_list<T, allocator>::const_iterator::operator=(const_iterator &&rhv)
-    {
-        ptr = rhv.ptr;
-        prev = rhv.prev;
-        next = rhv.next;
-        return *this;
+        if (m_compaction_ratio > 0.0 && m_tombstones > m_compaction_ratio * m_size)
+        {
+            Node *target = pos.ptr;
+            compact();
+            for (pos = begin(); pos.ptr != target; ++pos)
+            {
+            }
+        }
+        return pos;
     }
 
     template <typename T, typename allocator>
-    typename xor_list<T, allocator>::const_reference xor_list<T, allocator>::const_iterator::operator*() const
+    void xor_list<T, allocator>::compact()
     {
-        if (!this->ptr)
+        if (!m_tombstones)
         {
-            throw std::logic_error("Trying to dereference an invalid iterator");
+            return;
         }
-        return this->ptr->m_data;
-    }
 
-    template <typename T, typename allocator>
-    typename xor_list<T, allocator>::const_pointer xor_list<T, allocator>::const_iterator::operator->() const
-    {
-        if (!this->ptr)
+        Node *prev = nullptr;
+        Node *current = m_head;
+        Node *last = nullptr;
+        Node *last_prev = nullptr;
+
+        while (current)
         {
-            throw std::logic_error("Trying to dereference an invalid iterator");
+            Node *next = XOR(prev, current->m_next_prev);
+            if (current->m_next_prev.erased())
+            {
+                free_node(current);
+                --m_size;
+            }
+            else
+            {
+                if (last)
+                {
+                    last->m_next_prev = XOR(last_prev, current);
+                }
+                else
+                {
+                    m_head = current;
+                }
+                last_prev = last;
+                last = current;
+            }
+            prev = current;
+            current = next;
         }
-        return &this->ptr->m_data;
-    }
 
-    template <typename T, typename allocator>
-    const typename xor_list<T, allocator>::const_iterator &xor_list<T, allocator>::const_iterator::operator++()
-    {
-        if (!ptr)
+        if (last)
         {
-            throw std::logic_error("Incrementing an invalid iterator");
+            last->m_next_prev = XOR(last_prev, nullptr);
         }
-        Node *temp = ptr;
-        ptr = reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(prev) ^ reinterpret_cast<uintptr_t>(ptr->m_next_prev));
-        prev = temp;
-        next = (ptr) ? reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(temp) ^ reinterpret_cast<uintptr_t>(ptr->m_next_prev)) : nullptr;
-        return *this;
+        else
+        {
+            m_head = nullptr;
+        }
+        m_tail = last;
+        m_tombstones = 0;
     }
 
     template <typename T, typename allocator>
-    const typename xor_list<T, allocator>::const_iterator xor_list<T, allocator>::const_iterator::operator++(value_type)
+    void xor_list<T, allocator>::defragment()
     {
-        const_iterator tmp = *this;
-        ++(*this);
-        return tmp;
+        compact();
+        defragment(begin(), m_size);
     }
 
     template <typename T, typename allocator>
-    const typename xor_list<T, allocator>::const_iterator &xor_list<T, allocator>::const_iterator::operator--()
+    typename xor_list<T, allocator>::iterator xor_list<T, allocator>::defragment(iterator from, size_type budget)
     {
-        if (ptr == nullptr && prev == nullptr)
+        static_assert(packs_nodes, "defragment() requires the default Allocator");
+        Node *prev = from.prev;
+        Node *current = from.ptr;
+        if (!packed_capacity(packed_classes))
         {
-            throw std::logic_error("Decrementing an invalid iterator");
+            return from;
         }
 
-        if (ptr == nullptr)
+        while (current && budget)
         {
-            Node *temp = ptr;
-            ptr = prev;
-            next = temp;
-            prev = (ptr) ? reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(ptr->m_next_prev) ^ reinterpret_cast<uintptr_t>(next)) : nullptr;
-        }
-        else
+            // The largest class the live nodes left in this pass fill, so at
+            // most one small chunk per call is left partly empty. Counting
+            // stops once the largest chunk would be full.
+            size_type count = 0;
+            Node *ahead_prev = prev;
+            Node *ahead = current;
+            for (size_type steps = 0; ahead && steps < budget && count < packed_capacity(packed_classes); ++steps)
+            {
+                count += !ahead->m_next_prev.erased();
+                Node *next = XOR(ahead_prev, ahead->m_next_prev);
+                ahead_prev = ahead;
+                ahead = next;
+            }
+            unsigned chunk_class = packed_classes;
+            while (chunk_class > 1 && packed_capacity(chunk_class) > count)
+            {
+                --chunk_class;
+            }
+            count = packed_capacity(chunk_class);
+            if (!count)
+            {
+                return iterator(prev, current);
+            }
+
+            PackedChunk *chunk = new_packed_chunk(chunk_class);
+            Node *slots = reinterpret_cast<Node *>(reinterpret_cast<char *>(chunk) + packed_header);
+
+            try
+            {
+                while (current && budget && chunk->m_live < count)
+                {
+                    Node *next = XOR(prev, current->m_next_prev);
+                    --budget;
+
+                    if (current->m_next_prev.erased())
+                    {
+                        prev->m_next_prev = XOR(XOR(prev->m_next_prev, current), next);
+                        next->m_next_prev = XOR(XOR(next->m_next_prev, current), prev);
+                        free_node(current);
+                        --m_size;
+                        --m_tombstones;
+                        current = next;
+                        continue;
+                    }
+
+                    Node *node = ::new (slots + chunk->m_live) Node(std::move(current->m_data));
+                    node->m_next_prev = current->m_next_prev;
+                    node->m_next_prev.set_chunk_class(chunk_class);
+                    ++chunk->m_live;
+
+                    if (prev)
+                    {
+                        prev->m_next_prev = XOR(XOR(prev->m_next_prev, current), node);
+                    }
+                    else
+                    {
+                        m_head = node;
+                    }
+                    if (next)
+                    {
+                        next->m_next_prev = XOR(XOR(next->m_next_prev, current), node);
+                    }
+                    else
+                    {
+                        m_tail = node;
+                    }
+
+                    free_node(current);
+                    prev = node;
+                    current = next;
+                }
+            }
+            catch (...)
+            {
+                if (!chunk->m_live)
+                {
+                    free_packed_chunk(chunk);
+                }
+                throw;
+            }
+
+            if (!chunk->m_live)
+            {
+                free_packed_chunk(chunk);
+            }
+        }
+        return iterator(prev, current);
+    }
+
+    template <typename T, typename allocator>
+    double xor_list<T, allocator>::compaction_ratio() const
+    {
+        return m_compaction_ratio;
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::set_compaction_ratio(double ratio)
+    {
+        m_compaction_ratio = ratio;
+        if (m_compaction_ratio > 0.0 && m_tombstones > m_compaction_ratio * m_size)
+        {
+            compact();
+        }
+    }
+
+    // =====================================const iterator ============================================
+
+    template <typename T, typename allocator>
+    bool xor_list<T, allocator>::const_iterator::operator==(const const_iterator &rhv) const
+    {
+        return rhv.ptr == this->ptr;
+    }
+
+    template <typename T, typename allocator>
+    bool xor_list<T, allocator>::const_iterator::operator!=(const const_iterator &rhv) const
+    {
+        return rhv.ptr != this->ptr;
+    }
+
+    template <typename T, typename allocator>
+    xor_list<T, allocator>::const_iterator::const_iterator() : ptr{nullptr}, next{nullptr}, prev{nullptr} {}
+
+    template <typename T, typename allocator>
+    xor_list<T, allocator>::const_iterator::const_iterator(const const_iterator &rhv) : ptr{rhv.ptr}, prev{rhv.prev}, next{rhv.next} {}
+
+    template <typename T, typename allocator>
+    xor_list<T, allocator>::const_iterator::const_iterator(const_iterator &&rhv) : ptr{rhv.ptr}, prev{rhv.prev}, next{rhv.next} {}
+
+    template <typename T, typename allocator>
+    xor_list<T, allocator>::const_iterator::const_iterator(Node *prev, Node *ptr) : ptr{ptr}, prev{prev}
+    {
+        next = ptr ? reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(prev) ^ reinterpret_cast<uintptr_t>(static_cast<Node *>(ptr->m_next_prev))) : nullptr;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_iterator &xor_list<T, allocator>::const_iterator::operator=(const const_iterator &rhv)
+    {
+        ptr = rhv.ptr;
+        prev = rhv.prev;
+        next = rhv.next;
+        return *this;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_iterator &xor_list<T, allocator>::const_iterator::operator=(const_iterator &&rhv)
+    {
+        ptr = rhv.ptr;
+        prev = rhv.prev;
+        next = rhv.next;
+        return *this;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_reference xor_list<T, allocator>::const_iterator::operator*() const
+    {
+        if (!this->ptr)
+        {
+            throw std::logic_error("Trying to dereference an invalid iterator");
+        }
+        return this->ptr->m_data;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_pointer xor_list<T, allocator>::const_iterator::operator->() const
+    {
+        if (!this->ptr)
+        {
+            throw std::logic_error("Trying to dereference an invalid iterator");
+        }
+        return &this->ptr->m_data;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_iterator &xor_list<T, allocator>::const_iterator::operator++()
+    {
+        if (!ptr)
+        {
+            throw std::logic_error("Incrementing an invalid iterator");
+        }
+        do
         {
             Node *temp = ptr;
-            ptr = reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(ptr->m_next_prev) ^ reinterpret_cast<uintptr_t>(next));
-            next = temp;
-            prev = (ptr) ? reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(ptr->m_next_prev) ^ reinterpret_cast<uintptr_t>(next)) : nullptr;
+            ptr = reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(prev) ^ reinterpret_cast<uintptr_t>(static_cast<Node *>(ptr->m_next_prev)));
+            prev = temp;
+            next = (ptr) ? reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(temp) ^ reinterpret_cast<uintptr_t>(static_cast<Node *>(ptr->m_next_prev))) : nullptr;
+        } while (ptr && ptr->m_next_prev.erased());
+        return *this;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_iterator xor_list<T, allocator>::const_iterator::operator++(int)
+    {
+        const_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_iterator &xor_list<T, allocator>::const_iterator::operator--()
+    {
+        if (ptr == nullptr && prev == nullptr)
+        {
+            throw std::logic_error("Decrementing an invalid iterator");
         }
+
+        do
+        {
+            Node *temp = ptr;
+            ptr = prev;
+            next = temp;
+            prev = (ptr) ? reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(static_cast<Node *>(ptr->m_next_prev)) ^ reinterpret_cast<uintptr_t>(next)) : nullptr;
+        } while (ptr && ptr->m_next_prev.erased());
         return *this;
     }
 
     template <typename T, typename allocator>
-    const typename xor_list<T, allocator>::const_iterator xor_list<T, allocator>::const_iterator::operator--(value_type)
+    typename xor_list<T, allocator>::const_iterator xor_list<T, allocator>::const_iterator::operator--(int)
     {
         const_iterator tmp = *this;
         --(*this);
@@ -583,28 +956,31 @@ namespace my_std
     template <typename T, typename allocator>
     typename xor_list<T, allocator>::const_iterator xor_list<T, allocator>::cbegin() const
     {
-        return const_iterator(m_head, nullptr);
+        return const_iterator(nullptr, m_head);
     }
 
     template <typename T, typename allocator>
     typename xor_list<T, allocator>::const_iterator xor_list<T, allocator>::cend() const
     {
-        return const_iterator(m_tail, m_tail ? reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(m_tail->m_next_prev) ^ reinterpret_cast<uintptr_t>(nullptr)) : nullptr);
+        return const_iterator(m_tail, nullptr);
     }
 
     // iterator
 
     template <typename T, typename allocator>
-    xor_list<T, allocator>::iterator::iterator(const iterator &rhv) : const_iterator{rhv.ptr} {}
+    xor_list<T, allocator>::iterator::iterator() : const_iterator{} {}
+
+    template <typename T, typename allocator>
+    xor_list<T, allocator>::iterator::iterator(const iterator &rhv) : const_iterator{rhv} {}
 
     template <typename T, typename allocator>
-    xor_list<T, allocator>::iterator::iterator(iterator &&rhv) : const_iterator{rhv.ptr} {}
+    xor_list<T, allocator>::iterator::iterator(iterator &&rhv) : const_iterator{rhv} {}
 
     template <typename T, typename allocator>
-    xor_list<T, allocator>::iterator::iterator(Node *ptr1, Node *ptr2) : const_iterator{ptr1, ptr2} {}
+    xor_list<T, allocator>::iterator::iterator(Node *prev, Node *ptr) : const_iterator{prev, ptr} {}
 
     template <typename T, typename allocator>
-    const typename xor_list<T, allocator>::iterator &xor_list<T, allocator>::iterator::operator=(const iterator &rhv)
+    typename xor_list<T, allocator>::iterator &xor_list<T, allocator>::iterator::operator=(const iterator &rhv)
     {
         this->ptr = rhv.ptr;
         this->prev = rhv.prev;
@@ -613,7 +989,7 @@ namespace my_std
     }
 
     template <typename T, typename allocator>
-    const typename xor_list<T, allocator>::iterator &xor_list<T, allocator>::iterator::operator=(iterator &&rhv)
+    typename xor_list<T, allocator>::iterator &xor_list<T, allocator>::iterator::operator=(iterator &&rhv)
     {
         this->ptr = rhv.ptr;
         this->prev = rhv.prev;
@@ -622,7 +998,7 @@ namespace my_std
     }
 
     template <typename T, typename allocator>
-    typename xor_list<T, allocator>::reference xor_list<T, allocator>::iterator::operator*()
+    typename xor_list<T, allocator>::reference xor_list<T, allocator>::iterator::operator*() const
     {
         if (!this->ptr)
         {
@@ -632,7 +1008,7 @@ namespace my_std
     }
 
     template <typename T, typename allocator>
-    typename xor_list<T, allocator>::pointer_type xor_list<T, allocator>::iterator::operator->()
+    typename xor_list<T, allocator>::pointer_type xor_list<T, allocator>::iterator::operator->() const
     {
         if (!this->ptr)
         {
@@ -641,216 +1017,1137 @@ namespace my_std
         return &this->ptr->m_data;
     }
 
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::iterator &xor_list<T, allocator>::iterator::operator++()
+    {
+        const_iterator::operator++();
+        return *this;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::iterator xor_list<T, allocator>::iterator::operator++(int)
+    {
+        iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::iterator &xor_list<T, allocator>::iterator::operator--()
+    {
+        const_iterator::operator--();
+        return *this;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::iterator xor_list<T, allocator>::iterator::operator--(int)
+    {
+        iterator tmp = *this;
+        --(*this);
+        return tmp;
+    }
+
     template <typename T, typename allocator>
     typename xor_list<T, allocator>::iterator xor_list<T, allocator>::begin()
     {
-        return iterator(m_head, nullptr);
+        return iterator(nullptr, m_head);
     }
 
     template <typename T, typename allocator>
     typename xor_list<T, allocator>::iterator xor_list<T, allocator>::end()
     {
-        return iterator(m_tail, m_tail ? reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(m_tail->m_next_prev) ^ reinterpret_cast<uintptr_t>(nullptr)) : nullptr);
+        return iterator(m_tail, nullptr);
     }
 
     template <typename T, typename allocator>
-    void xor_list<T, allocator>::assign(size_type count, value_type val)
+    typename xor_list<T, allocator>::const_iterator xor_list<T, allocator>::begin() const
     {
-        clear();
-        for (int i = {}; i < count; ++i)
+        return cbegin();
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_iterator xor_list<T, allocator>::end() const
+    {
+        return cend();
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::reverse_iterator xor_list<T, allocator>::rbegin()
+    {
+        return reverse_iterator(iterator(nullptr, m_tail));
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::reverse_iterator xor_list<T, allocator>::rend()
+    {
+        return reverse_iterator(iterator(m_head, nullptr));
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_reverse_iterator xor_list<T, allocator>::rbegin() const
+    {
+        return crbegin();
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_reverse_iterator xor_list<T, allocator>::rend() const
+    {
+        return crend();
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_reverse_iterator xor_list<T, allocator>::crbegin() const
+    {
+        return const_reverse_iterator(const_iterator(nullptr, m_tail));
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_reverse_iterator xor_list<T, allocator>::crend() const
+    {
+        return const_reverse_iterator(const_iterator(m_head, nullptr));
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::template range<typename xor_list<T, allocator>::reverse_iterator> xor_list<T, allocator>::reversed()
+    {
+        return range<reverse_iterator>(rbegin(), rend());
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::template range<typename xor_list<T, allocator>::const_reverse_iterator> xor_list<T, allocator>::reversed() const
+    {
+        return range<const_reverse_iterator>(crbegin(), crend());
+    }
+
+    // =====================================reverse iterators ============================================
+
+    template <typename T, typename allocator>
+    xor_list<T, allocator>::const_reverse_iterator::const_reverse_iterator(const_iterator it) : m_it{it} {}
+
+    template <typename T, typename allocator>
+    xor_list<T, allocator>::const_reverse_iterator::const_reverse_iterator(const reverse_iterator &rhv) : m_it{rhv.m_it} {}
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_iterator xor_list<T, allocator>::const_reverse_iterator::base() const
+    {
+        // m_it.prev is the node after m_it.ptr in list order; it may be a
+        // tombstone, which a forward iterator must not rest on.
+        const_iterator result(m_it.ptr, m_it.prev);
+        if (result.ptr && result.ptr->m_next_prev.erased())
         {
-            push_back(val);
+            ++result;
         }
+        return result;
     }
 
     template <typename T, typename allocator>
-    template <typename inputIt>
-    void xor_list<T, allocator>::assign(inputIt first, inputIt last)
+    typename xor_list<T, allocator>::const_reverse_iterator::reference xor_list<T, allocator>::const_reverse_iterator::operator*() const
     {
-        clear();
+        return *m_it;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_reverse_iterator::pointer xor_list<T, allocator>::const_reverse_iterator::operator->() const
+    {
+        return m_it.operator->();
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_reverse_iterator &xor_list<T, allocator>::const_reverse_iterator::operator++()
+    {
+        ++m_it;
+        return *this;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_reverse_iterator xor_list<T, allocator>::const_reverse_iterator::operator++(int)
+    {
+        const_reverse_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_reverse_iterator &xor_list<T, allocator>::const_reverse_iterator::operator--()
+    {
+        --m_it;
+        return *this;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::const_reverse_iterator xor_list<T, allocator>::const_reverse_iterator::operator--(int)
+    {
+        const_reverse_iterator tmp = *this;
+        --(*this);
+        return tmp;
+    }
+
+    template <typename T, typename allocator>
+    bool xor_list<T, allocator>::const_reverse_iterator::operator==(const const_reverse_iterator &rhv) const
+    {
+        return m_it == rhv.m_it;
+    }
+
+    template <typename T, typename allocator>
+    bool xor_list<T, allocator>::const_reverse_iterator::operator!=(const const_reverse_iterator &rhv) const
+    {
+        return m_it != rhv.m_it;
+    }
+
+    template <typename T, typename allocator>
+    xor_list<T, allocator>::reverse_iterator::reverse_iterator(iterator it) : m_it{it} {}
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::iterator xor_list<T, allocator>::reverse_iterator::base() const
+    {
+        iterator result(m_it.ptr, m_it.prev);
+        if (result.ptr && result.ptr->m_next_prev.erased())
+        {
+            ++result;
+        }
+        return result;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::reverse_iterator::reference xor_list<T, allocator>::reverse_iterator::operator*() const
+    {
+        return *m_it;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::reverse_iterator::pointer xor_list<T, allocator>::reverse_iterator::operator->() const
+    {
+        return m_it.operator->();
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::reverse_iterator &xor_list<T, allocator>::reverse_iterator::operator++()
+    {
+        ++m_it;
+        return *this;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::reverse_iterator xor_list<T, allocator>::reverse_iterator::operator++(int)
+    {
+        reverse_iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::reverse_iterator &xor_list<T, allocator>::reverse_iterator::operator--()
+    {
+        --m_it;
+        return *this;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::reverse_iterator xor_list<T, allocator>::reverse_iterator::operator--(int)
+    {
+        reverse_iterator tmp = *this;
+        --(*this);
+        return tmp;
+    }
+
+    template <typename T, typename allocator>
+    bool xor_list<T, allocator>::reverse_iterator::operator==(const reverse_iterator &rhv) const
+    {
+        return m_it == rhv.m_it;
+    }
+
+    template <typename T, typename allocator>
+    bool xor_list<T, allocator>::reverse_iterator::operator!=(const reverse_iterator &rhv) const
+    {
+        return m_it != rhv.m_it;
+    }
+
+    template <typename T, typename allocator>
+    template <typename iter>
+    xor_list<T, allocator>::range<iter>::range(iter first, iter last) : m_first(first), m_last(last) {}
+
+    template <typename T, typename allocator>
+    template <typename iter>
+    iter xor_list<T, allocator>::range<iter>::begin() const
+    {
+        return m_first;
+    }
+
+    template <typename T, typename allocator>
+    template <typename iter>
+    iter xor_list<T, allocator>::range<iter>::end() const
+    {
+        return m_last;
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::assign(size_type count, value_type val)
+    {
+        clear();
+        for (int i = {}; i < count; ++i)
+        {
+            push_back(val);
+        }
+    }
+
+    template <typename T, typename allocator>
+    template <typename inputIt>
+    void xor_list<T, allocator>::assign(inputIt first, inputIt last)
+    {
+        clear();
+
+        for (auto it = first; it != last; ++it)
+        {
+            push_back(*it);
+        }
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::assign(std::initializer_list<value_type> init)
+    {
+        clear();
+
+        for (const auto &it : init)
+        {
+            push_back(it);
+        }
+    }
+
+    template <typename T, typename allocator>
+    bool xor_list<T, allocator>::operator==(const xor_list &rhv) const
+    {
+        if (this == &rhv)
+        {
+            return true;
+        }
+        if (size() != rhv.size())
+        {
+            return false;
+        }
+
+        Node *lhs_prev = nullptr;
+        Node *lhs = m_head;
+        Node *rhs_prev = nullptr;
+        Node *rhs = rhv.m_head;
+        while (lhs)
+        {
+            if (!(lhs->m_data == rhs->m_data))
+            {
+                return false;
+            }
+            advance(lhs_prev, lhs);
+            rhv.advance(rhs_prev, rhs);
+        }
+        return true;
+    }
+
+    template <typename T, typename allocator>
+    template <typename U>
+    std::compare_three_way_result_t<U> xor_list<T, allocator>::operator<=>(const xor_list &rhv) const
+    {
+        Node *lhs_prev = nullptr;
+        Node *lhs = m_head;
+        Node *rhs_prev = nullptr;
+        Node *rhs = rhv.m_head;
+        while (lhs && rhs)
+        {
+            if (auto cmp = lhs->m_data <=> rhs->m_data; cmp != 0)
+            {
+                return cmp;
+            }
+            advance(lhs_prev, lhs);
+            rhv.advance(rhs_prev, rhs);
+        }
+        return (lhs != nullptr) <=> (rhs != nullptr);
+    }
+
+    template <typename T, typename allocator>
+    template <typename Compare>
+    void xor_list<T, allocator>::sort_chain(Node *&head, Node *&tail, size_type count, Compare comp)
+    {
+        chain::sort(head, tail, count, [&comp](Node *a, Node *b)
+                    { return comp(a->m_data, b->m_data); });
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::advance(Node *&prev, Node *&current) const
+    {
+        do
+        {
+            Node *next = XOR(prev, current->m_next_prev);
+            prev = current;
+            current = next;
+        } while (current && current->m_next_prev.erased());
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::link_between(Node *prev, Node *next, Node *node)
+    {
+        node->m_next_prev = XOR(prev, next);
+        if (prev)
+        {
+            prev->m_next_prev = XOR(XOR(prev->m_next_prev, next), node);
+        }
+        else
+        {
+            m_head = node;
+        }
+        if (next)
+        {
+            next->m_next_prev = XOR(XOR(next->m_next_prev, prev), node);
+        }
+        else
+        {
+            m_tail = node;
+        }
+        ++m_size;
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::unlink_node(Node *&prev, Node *&node)
+    {
+        Node *next = XOR(prev, node->m_next_prev);
+        if (prev)
+        {
+            prev->m_next_prev = XOR(XOR(prev->m_next_prev, node), next);
+        }
+        else
+        {
+            m_head = next;
+        }
+        if (next)
+        {
+            next->m_next_prev = XOR(XOR(next->m_next_prev, node), prev);
+        }
+        else
+        {
+            m_tail = prev;
+        }
+        free_node(node);
+        --m_size;
+
+        if (m_head && m_head->m_next_prev.erased())
+        {
+            pop_front();
+        }
+        if (m_tail && m_tail->m_next_prev.erased())
+        {
+            pop_back();
+        }
+
+        if (!next)
+        {
+            prev = m_tail;
+            node = nullptr;
+        }
+        else if (!prev)
+        {
+            node = m_head;
+        }
+        else
+        {
+            node = next;
+            while (node->m_next_prev.erased())
+            {
+                Node *after = XOR(prev, node->m_next_prev);
+                prev = node;
+                node = after;
+            }
+        }
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::merge(xor_list &other)
+    {
+        merge(other, std::less<>());
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::merge(xor_list &&other)
+    {
+        merge(other, std::less<>());
+    }
+
+    template <typename T, typename allocator>
+    template <typename Compare>
+    void xor_list<T, allocator>::merge(xor_list &&other, Compare comp)
+    {
+        merge(other, comp);
+    }
+
+    template <typename T, typename allocator>
+    template <typename Compare>
+    void xor_list<T, allocator>::merge(xor_list &other, Compare comp)
+    {
+        if (this == std::addressof(other) || !other.m_head)
+        {
+            return;
+        }
+        require_same_allocator(other);
+        compact();
+        other.compact();
+
+        Node *new_head = nullptr;
+        Node *new_tail = nullptr;
+
+        Node *l1 = m_head;
+        Node *l2 = other.m_head;
+
+        Node *prev_l1 = nullptr;
+        Node *prev_l2 = nullptr;
+
+        while (l1 && l2)
+        {
+            if (comp(l2->m_data, l1->m_data))
+            {
+                Node *next_l2 = XOR(prev_l2, l2->m_next_prev);
+                chain::link_back(new_head, new_tail, l2);
+                prev_l2 = l2;
+                l2 = next_l2;
+            }
+            else
+            {
+                Node *next_l1 = XOR(prev_l1, l1->m_next_prev);
+                chain::link_back(new_head, new_tail, l1);
+                prev_l1 = l1;
+                l1 = next_l1;
+            }
+        }
+
+        Node *rest = l1 ? l1 : l2;
+        Node *rest_prev = l1 ? prev_l1 : prev_l2;
+        Node *rest_tail = l1 ? m_tail : other.m_tail;
+        if (rest)
+        {
+            if (new_tail)
+            {
+                new_tail->m_next_prev = XOR(new_tail->m_next_prev, rest);
+                rest->m_next_prev = XOR(XOR(rest->m_next_prev, rest_prev), new_tail);
+            }
+            else
+            {
+                new_head = rest;
+            }
+            new_tail = rest_tail;
+        }
+
+        m_head = new_head;
+        m_tail = new_tail;
+        m_size += other.m_size;
+
+        other.m_head = nullptr;
+        other.m_tail = nullptr;
+        other.m_size = 0;
+    }
+
+    template <typename T, typename allocator>
+    template <typename Pred>
+    typename xor_list<T, allocator>::iterator xor_list<T, allocator>::partition(Pred pred)
+    {
+        return stable_partition(pred);
+    }
+
+    template <typename T, typename allocator>
+    template <typename Pred>
+    typename xor_list<T, allocator>::iterator xor_list<T, allocator>::stable_partition(Pred pred)
+    {
+        compact();
+
+        Node *yes_head = nullptr;
+        Node *yes_tail = nullptr;
+        Node *no_head = nullptr;
+        Node *no_tail = nullptr;
+
+        Node *prev = nullptr;
+        Node *current = m_head;
+        while (current)
+        {
+            Node *next = XOR(prev, current->m_next_prev);
+            if (pred(current->m_data))
+            {
+                chain::link_back(yes_head, yes_tail, current);
+            }
+            else
+            {
+                chain::link_back(no_head, no_tail, current);
+            }
+            prev = current;
+            current = next;
+        }
+
+        Node *boundary_prev = yes_tail;
+        chain::append(yes_head, yes_tail, no_head, no_tail);
+        m_head = yes_head;
+        m_tail = yes_tail;
+        return iterator(boundary_prev, no_head);
+    }
+
+    template <typename T, typename allocator>
+    template <typename Pred>
+    typename xor_list<T, allocator>::size_type xor_list<T, allocator>::partition_into(Pred pred, xor_list &out)
+    {
+        if (this == std::addressof(out))
+        {
+            return 0;
+        }
+        require_same_allocator(out);
+        compact();
+
+        Node *keep_head = nullptr;
+        Node *keep_tail = nullptr;
+        size_type moved = 0;
+
+        Node *prev = nullptr;
+        Node *current = m_head;
+        while (current)
+        {
+            Node *next = XOR(prev, current->m_next_prev);
+            if (pred(current->m_data))
+            {
+                chain::link_back(out.m_head, out.m_tail, current);
+                ++moved;
+            }
+            else
+            {
+                chain::link_back(keep_head, keep_tail, current);
+            }
+            prev = current;
+            current = next;
+        }
+
+        m_head = keep_head;
+        m_tail = keep_tail;
+        m_size -= moved;
+        out.m_size += moved;
+        return moved;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::iterator xor_list<T, allocator>::nth_element(size_type n)
+    {
+        return nth_element(n, std::less<>());
+    }
+
+    template <typename T, typename allocator>
+    template <typename Compare>
+    typename xor_list<T, allocator>::iterator xor_list<T, allocator>::nth_element(size_type n, Compare comp)
+    {
+        compact();
+        if (n >= m_size)
+        {
+            return end();
+        }
+
+        Node *front_head = nullptr;
+        Node *front_tail = nullptr;
+        Node *back_head = nullptr;
+        Node *back_tail = nullptr;
+
+        Node *head = m_head;
+        Node *tail = m_tail;
+        size_type count = m_size;
+        Node *found = nullptr;
+        Node *found_prev = nullptr;
+
+        while (!found)
+        {
+            if (count <= 16)
+            {
+                sort_chain(head, tail, count, comp);
+                found_prev = front_tail;
+                found = head;
+                for (Node *prev = nullptr; n; --n)
+                {
+                    Node *next = XOR(prev, found->m_next_prev);
+                    prev = found;
+                    found_prev = found;
+                    found = next;
+                }
+                chain::append(front_head, front_tail, head, tail);
+                break;
+            }
+
+            Node *pivot = head;
+            Node *prev = nullptr;
+            for (size_type i = 0; i < count / 2; ++i)
+            {
+                Node *next = XOR(prev, pivot->m_next_prev);
+                prev = pivot;
+                pivot = next;
+            }
+
+            Node *less_head = nullptr;
+            Node *less_tail = nullptr;
+            Node *equal_head = nullptr;
+            Node *equal_tail = nullptr;
+            Node *greater_head = nullptr;
+            Node *greater_tail = nullptr;
+            size_type less_count = 0;
+            size_type equal_count = 0;
+
+            prev = nullptr;
+            Node *current = head;
+            while (current)
+            {
+                Node *next = XOR(prev, current->m_next_prev);
+                if (comp(current->m_data, pivot->m_data))
+                {
+                    chain::link_back(less_head, less_tail, current);
+                    ++less_count;
+                }
+                else if (comp(pivot->m_data, current->m_data))
+                {
+                    chain::link_back(greater_head, greater_tail, current);
+                }
+                else
+                {
+                    chain::link_back(equal_head, equal_tail, current);
+                    ++equal_count;
+                }
+                prev = current;
+                current = next;
+            }
+
+            if (n < less_count)
+            {
+                chain::append(equal_head, equal_tail, greater_head, greater_tail);
+                chain::append(equal_head, equal_tail, back_head, back_tail);
+                back_head = equal_head;
+                back_tail = equal_tail;
+                head = less_head;
+                tail = less_tail;
+                count = less_count;
+            }
+            else if (n < less_count + equal_count)
+            {
+                chain::append(front_head, front_tail, less_head, less_tail);
+                n -= less_count;
+                found_prev = front_tail;
+                found = equal_head;
+                for (Node *step_prev = nullptr; n; --n)
+                {
+                    Node *next = XOR(step_prev, found->m_next_prev);
+                    step_prev = found;
+                    found_prev = found;
+                    found = next;
+                }
+                chain::append(front_head, front_tail, equal_head, equal_tail);
+                chain::append(front_head, front_tail, greater_head, greater_tail);
+            }
+            else
+            {
+                chain::append(front_head, front_tail, less_head, less_tail);
+                chain::append(front_head, front_tail, equal_head, equal_tail);
+                n -= less_count + equal_count;
+                head = greater_head;
+                tail = greater_tail;
+                count -= less_count + equal_count;
+            }
+        }
+
+        chain::append(front_head, front_tail, back_head, back_tail);
+        m_head = front_head;
+        m_tail = front_tail;
+        return iterator(found_prev, found);
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::partial_sort(size_type k)
+    {
+        partial_sort(k, std::less<>());
+    }
+
+    template <typename T, typename allocator>
+    template <typename Compare>
+    void xor_list<T, allocator>::partial_sort(size_type k, Compare comp)
+    {
+        compact();
+        if (k == 0 || !m_head)
+        {
+            return;
+        }
+        if (k >= m_size)
+        {
+            sort_chain(m_head, m_tail, m_size, comp);
+            return;
+        }
+
+        iterator nth = nth_element(k - 1, comp);
+        Node *rest = nth.next;
+        Node *head = m_head;
+        Node *tail = nth.ptr;
+        Node *rest_tail = m_tail;
+        if (rest)
+        {
+            tail->m_next_prev = XOR(tail->m_next_prev, rest);
+            rest->m_next_prev = XOR(rest->m_next_prev, tail);
+        }
+
+        sort_chain(head, tail, k, comp);
+        chain::append(head, tail, rest, rest ? rest_tail : nullptr);
+        m_head = head;
+        m_tail = tail;
+    }
+
+    template <typename T, typename allocator, typename Compare>
+    xor_list<T, allocator> merge_k(std::span<xor_list<T, allocator> *> lists, Compare comp)
+    {
+        using Node = typename xor_list<T, allocator>::Node;
+        struct cursor
+        {
+            Node *prev;
+            Node *current;
+            std::size_t source;
+        };
+
+        xor_list<T, allocator> result(lists.empty() ? allocator() : lists[0]->get_allocator());
+        for (xor_list<T, allocator> *list : lists)
+        {
+            result.require_same_allocator(*list);
+        }
+
+        std::vector<cursor> heap;
+        heap.reserve(lists.size());
+        for (std::size_t i = 0; i < lists.size(); ++i)
+        {
+            xor_list<T, allocator> &list = *lists[i];
+            if (std::addressof(list) == std::addressof(result) || !list.m_head)
+            {
+                continue;
+            }
+            list.compact();
+            heap.push_back(cursor{nullptr, list.m_head, i});
+            result.m_size += list.m_size;
+            list.m_head = nullptr;
+            list.m_tail = nullptr;
+            list.m_size = 0;
+        }
+
+        auto later = [&comp](const cursor &a, const cursor &b)
+        {
+            if (comp(b.current->m_data, a.current->m_data))
+            {
+                return true;
+            }
+            return !comp(a.current->m_data, b.current->m_data) && a.source > b.source;
+        };
+        std::make_heap(heap.begin(), heap.end(), later);
+
+        while (!heap.empty())
+        {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            cursor &top = heap.back();
+            Node *next = result.XOR(top.prev, top.current->m_next_prev);
+            xor_chain<Node>::link_back(result.m_head, result.m_tail, top.current);
+            top.prev = top.current;
+            top.current = next;
+            if (next)
+            {
+                std::push_heap(heap.begin(), heap.end(), later);
+            }
+            else
+            {
+                heap.pop_back();
+            }
+        }
+        return result;
+    }
 
-        for (auto it = first; it != last; ++it)
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::require_same_allocator(const xor_list &other) const
+    {
+        if (!(m_allocator == other.m_allocator))
         {
-            push_back(*it);
+            throw std::logic_error("Lists use unequal allocators");
         }
     }
 
     template <typename T, typename allocator>
-    void xor_list<T, allocator>::assign(std::initializer_list<value_type> init)
+    void xor_list<T, allocator>::splice_back(xor_list &other)
     {
-        clear();
+        if (this == std::addressof(other) || !other.m_head)
+        {
+            return;
+        }
+        require_same_allocator(other);
 
-        for (const auto &it : init)
+        if (!m_tail)
         {
-            push_back(it);
+            m_head = other.m_head;
+        }
+        else
+        {
+            m_tail->m_next_prev = XOR(m_tail->m_next_prev, other.m_head);
+            other.m_head->m_next_prev = XOR(other.m_head->m_next_prev, m_tail);
         }
+        m_tail = other.m_tail;
+        m_size += other.m_size;
+        m_tombstones += other.m_tombstones;
+
+        other.m_head = nullptr;
+        other.m_tail = nullptr;
+        other.m_size = 0;
+        other.m_tombstones = 0;
     }
 
     template <typename T, typename allocator>
-    bool xor_list<T, allocator>::operator==(const xor_list &rhv) const
+    xor_list<T, allocator> xor_list<T, allocator>::split_front(size_type count)
     {
-        auto it_lhs = this->begin();
-        auto it_rhs = rhv.begin();
+        compact();
+
+        xor_list result(get_allocator());
+        if (count == 0)
+        {
+            return result;
+        }
+        if (count >= m_size)
+        {
+            result.swap(*this);
+            return result;
+        }
 
-        while (it_lhs != this->end() && it_rhs != rhv.end())
+        Node *prev = nullptr;
+        Node *current = nullptr;
+        if (count <= m_size / 2)
         {
-            if (!(*it_lhs == *it_rhs))
+            current = m_head;
+            for (size_type i = 0; i < count; ++i)
             {
-                return false;
+                Node *next = XOR(prev, current->m_next_prev);
+                prev = current;
+                current = next;
+            }
+        }
+        else
+        {
+            Node *after = nullptr;
+            current = m_tail;
+            for (size_type i = m_size - 1; i > count; --i)
+            {
+                Node *before = XOR(after, current->m_next_prev);
+                after = current;
+                current = before;
             }
-            ++it_lhs;
-            ++it_rhs;
+            prev = XOR(after, current->m_next_prev);
         }
 
-        return it_lhs == this->end() && it_rhs == rhv.end();
+        prev->m_next_prev = XOR(prev->m_next_prev, current);
+        current->m_next_prev = XOR(current->m_next_prev, prev);
+
+        result.m_head = m_head;
+        result.m_tail = prev;
+        result.m_size = count;
+        m_head = current;
+        m_size -= count;
+        return result;
     }
 
     template <typename T, typename allocator>
-    void xor_list<T, allocator>::merge(xor_list &other)
+    typename xor_list<T, allocator>::size_type xor_list<T, allocator>::parse_from(std::string_view text)
+    {
+        xor_list batch(get_allocator());
+        batch.parse_prefix(text, true);
+        size_type count = batch.m_size;
+        splice_back(batch);
+        return count;
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::size_type xor_list<T, allocator>::load_text(const std::string &path)
+    {
+        xor_list batch(get_allocator());
+        read_blocks(path, [&batch](std::string_view block, bool last)
+                    { return batch.parse_prefix(block, last); });
+        size_type count = batch.m_size;
+        splice_back(batch);
+        return count;
+    }
+
+    template <typename T, typename allocator>
+    template <typename Consumer>
+    typename xor_list<T, allocator>::size_type xor_list<T, allocator>::stream_text(const std::string &path, size_type chunk, Consumer consume, const allocator &aloc)
     {
-        if (this == std::addressof(other))
+        if (chunk == 0)
         {
-            return;
+            throw std::logic_error("Chunk size must be positive");
         }
 
-        Node *new_head = nullptr;
-        Node *new_tail = nullptr;
+        xor_list batch(aloc);
+        size_type total = 0;
+        read_blocks(path, [&](std::string_view block, bool last)
+                    {
+                        std::size_t used = batch.parse_prefix(block, last);
+                        while (batch.m_size >= chunk || (last && batch.m_size))
+                        {
+                            xor_list part = batch.split_front(chunk);
+                            total += part.m_size;
+                            consume(std::move(part));
+                        }
+                        return used; });
+        return total;
+    }
 
-        Node *l1 = m_head;
-        Node *l2 = other.m_head;
+    template <typename T, typename allocator>
+    std::size_t xor_list<T, allocator>::parse_prefix(std::string_view text, bool final)
+    {
+        static_assert(std::is_arithmetic_v<T>, "Text parsing requires an arithmetic element type");
+        auto is_space = [](char c)
+        {
+            return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+        };
 
-        Node *prev_l1 = nullptr;
-        Node *prev_l2 = nullptr;
-        Node *prev_new_tail = nullptr;
+        const char *begin = text.data();
+        const char *end = begin + text.size();
+        const char *current = begin;
+        std::size_t consumed = text.size();
 
-        while (l1 && l2)
+        // On the default Allocator nodes are carved in parse order from a
+        // packed chunk sized to the text still ahead, so loading needs no
+        // malloc per element and leaves the list laid out as defragment()
+        // would. Short inputs, and other allocators, take the per-node path.
+        PackedChunk *chunk = nullptr;
+        Node *slot = nullptr;
+        size_type slots_left = 0;
+        unsigned chunk_class = 0;
+        try
         {
-            if (l1->val <= l2->val)
+            while (true)
             {
-                if (!new_head)
+                while (current != end && is_space(*current))
                 {
+                    ++current;
+                }
+                if (current == end)
+                {
+                    break;
+                }
 
-                    new_head = l1;
-                    new_tail = l1;
-                    prev_new_tail = nullptr;
+                const char *token_end = current;
+                while (token_end != end && !is_space(*token_end))
+                {
+                    ++token_end;
                 }
-                else
+                if (token_end == end && !final)
                 {
+                    consumed = current - begin;
+                    break;
+                }
 
-                    Node *next_l1 = XOR(prev_l1, l1->m_next_prev);
-                    new_tail->m_next_prev = XOR(prev_new_tail, l1);
-                    prev_new_tail = new_tail;
-                    new_tail = l1;
-                    l1 = next_l1;
+                T value;
+                auto [ptr, ec] = std::from_chars(current, token_end, value);
+                if (ec != std::errc() || ptr != token_end)
+                {
+                    throw std::logic_error("Malformed number");
                 }
 
-                Node *next_l1 = XOR(prev_l1, l1->m_next_prev);
-                prev_l1 = l1;
-                l1 = next_l1;
-            }
-            else
-            {
-                if (!new_head)
+                if constexpr (packs_nodes)
+                {
+                    if (!slots_left)
+                    {
+                        release_packed_chunk(chunk);
+                        chunk = nullptr;
+                        size_type most_tokens = (end - current + 1) / 2;
+                        chunk_class = packed_classes;
+                        while (chunk_class && packed_capacity(chunk_class) > most_tokens)
+                        {
+                            --chunk_class;
+                        }
+                        if (chunk_class && packed_capacity(chunk_class))
+                        {
+                            chunk = new_packed_chunk(chunk_class);
+                            chunk->m_live = 1;
+                            slot = reinterpret_cast<Node *>(reinterpret_cast<char *>(chunk) + packed_header);
+                            slots_left = packed_capacity(chunk_class);
+                        }
+                    }
+                }
+
+                Node *node;
+                if (slots_left)
                 {
-                    new_head = l2;
-                    new_tail = l2;
-                    prev_new_tail = nullptr;
+                    node = ::new (slot++) Node(value);
+                    node->m_next_prev.set_chunk_class(chunk_class);
+                    ++chunk->m_live;
+                    --slots_left;
                 }
                 else
                 {
-
-                    Node *next_l2 = XOR(prev_l2, l2->m_next_prev);
-                    new_tail->m_next_prev = XOR(prev_new_tail, l2);
-                    prev_new_tail = new_tail;
-                    new_tail = l2;
-                    l2 = next_l2;
+                    node = m_allocator.allocate();
+                    m_allocator.construct(node, value);
                 }
-
-                Node *next_l2 = XOR(prev_l2, l2->m_next_prev);
-                prev_l2 = l2;
-                l2 = next_l2;
+                chain::link_back(m_head, m_tail, node);
+                ++m_size;
+                current = token_end;
             }
         }
+        catch (...)
+        {
+            release_packed_chunk(chunk);
+            throw;
+        }
+        release_packed_chunk(chunk);
+        return consumed;
+    }
 
-        while (l1)
+    template <typename T, typename allocator>
+    template <typename BlockFn>
+    void xor_list<T, allocator>::read_blocks(const std::string &path, BlockFn on_block)
+    {
+        std::unique_ptr<std::FILE, int (*)(std::FILE *)> file(std::fopen(path.c_str(), "rb"), &std::fclose);
+        if (!file)
         {
-            if (!new_head)
-            {
-                new_head = l1;
-                new_tail = l1;
-                prev_new_tail = nullptr;
-            }
-            else
-            {
-                Node *next_l1 = XOR(prev_l1, l1->m_next_prev);
-                new_tail->m_next_prev = XOR(prev_new_tail, l1);
-                prev_new_tail = new_tail;
-                new_tail = l1;
-                l1 = next_l1;
-            }
+            throw std::logic_error("Cannot open file");
         }
 
-        while (l2)
+        std::vector<char> buffer(std::size_t(1) << 20);
+        std::size_t carry = 0;
+        while (true)
         {
-            if (!new_head)
+            if (carry == buffer.size())
             {
-                new_head = l2;
-                new_tail = l2;
-                prev_new_tail = nullptr;
+                buffer.resize(buffer.size() * 2);
             }
-            else
+            std::size_t wanted = buffer.size() - carry;
+            std::size_t got = std::fread(buffer.data() + carry, 1, wanted, file.get());
+            if (std::ferror(file.get()))
             {
-                Node *next_l2 = XOR(prev_l2, l2->m_next_prev);
-                new_tail->m_next_prev = XOR(prev_new_tail, l2);
-                prev_new_tail = new_tail;
-                new_tail = l2;
-                l2 = next_l2;
+                throw std::logic_error("Cannot read file");
             }
-        }
 
-        m_head = new_head;
-        m_tail = new_tail;
+            bool last = got < wanted;
+            std::size_t total = carry + got;
+            std::size_t used = on_block(std::string_view(buffer.data(), total), last);
+            if (last)
+            {
+                return;
+            }
+            carry = total - used;
+            std::memmove(buffer.data(), buffer.data() + used, carry);
+        }
+    }
 
-        other.m_head = nullptr;
-        other.m_tail = nullptr;
+    template <typename T, typename allocator>
+    xor_list<T, allocator> xor_list<T, allocator>::split_back(size_type count)
+    {
+        reverse();
+        xor_list result = split_front(count);
+        reverse();
+        result.reverse();
+        return result;
     }
 
     template <typename T, typename allocator>
     typename xor_list<T, allocator>::iterator xor_list<T, allocator>::erase(iterator pos)
     {
-        if (pos.ptr == nullptr)
+        if (pos.ptr == nullptr || pos.ptr->m_next_prev.erased())
         {
             throw std::logic_error("Attempt to erase an invalid iterator");
         }
 
-        Node *node_to_delete = pos.ptr;
-        Node *prev = XOR(nullptr, node_to_delete->m_next_prev);
-        Node *next = XOR(prev, node_to_delete->m_next_prev);
-
-        if (prev)
-        {
-            prev->m_next_prev = XOR(XOR(prev->m_next_prev, node_to_delete), next);
-        }
-        else
-        {
-
-            m_head = next;
-        }
-
-        if (next)
-        {
-            next->m_next_prev = XOR(prev, XOR(next->m_next_prev, node_to_delete));
-        }
-        else
-        {
-
-            m_tail = prev;
-        }
-
-        m_allocator.destroy(node_to_delete);
-        m_allocator.deallocate(node_to_delete);
-
-        return iterator(next);
+        Node *prev = pos.prev;
+        Node *current = pos.ptr;
+        unlink_node(prev, current);
+        return iterator(prev, current);
     }
 
     template <typename T, typename allocator>
@@ -860,7 +2157,7 @@ namespace my_std
         {
             f = erase(f);
         }
-        return l;
+        return f;
     }
 
     template <typename T, typename allocator>
@@ -879,84 +2176,81 @@ namespace my_std
     template <typename T, typename allocator>
     typename xor_list<T, allocator>::iterator xor_list<T, allocator>::insert(iterator pos, iterator f, iterator l)
     {
-        while (f != l)
+        iterator first = pos;
+        for (bool inserted = false; f != l; ++f)
         {
-            pos = insert(pos, *f++);
+            iterator it = insert(pos, *f);
+            if (!inserted)
+            {
+                first = it;
+                inserted = true;
+            }
+            pos = iterator(it.ptr, pos.ptr);
         }
-        return pos;
+        return first;
     }
 
     template <typename T, typename allocator>
     typename xor_list<T, allocator>::iterator xor_list<T, allocator>::insert(iterator pos, std::initializer_list<value_type> init)
     {
+        iterator first = pos;
+        bool inserted = false;
         for (const auto &val : init)
         {
-            pos = insert(pos, val);
+            iterator it = insert(pos, val);
+            if (!inserted)
+            {
+                first = it;
+                inserted = true;
+            }
+            pos = iterator(it.ptr, pos.ptr);
         }
-        return pos;
+        return first;
     }
 
     template <typename T, typename allocator>
     typename xor_list<T, allocator>::iterator xor_list<T, allocator>::insert(iterator pos, value_type val)
     {
-        Node *new_node = new Node(val);
-        if (pos == begin())
-        {
-            new_node->m_next_prev = m_head;
-            if (m_head)
-            {
-                m_head->m_prev_next = new_node;
-            }
-            m_head = new_node;
-        }
-        else
-        {
-            Node *current = pos.m_head;
-            Node *previous = current->m_prev_next;
-            new_node->m_next_prev = current;
-            new_node->m_prev_next = previous;
-            if (previous)
-            {
-                previous->m_next_prev = new_node;
-            }
-            current->m_prev_next = new_node;
-        }
-        return iterator(new_node);
+        Node *new_node = m_allocator.allocate();
+        m_allocator.construct(new_node, std::move(val));
+        link_between(pos.prev, pos.ptr, new_node);
+        return iterator(pos.prev, new_node);
     }
 
     template <typename T, typename allocator>
     typename xor_list<T, allocator>::iterator xor_list<T, allocator>::rfind(const_reference elem)
     {
-        Node *current = m_head;
-        Node *last_found = nullptr;
+        Node *next = nullptr;
+        Node *current = m_tail;
 
         while (current)
         {
-            if (current->m_data == elem)
+            Node *prev = XOR(current->m_next_prev, next);
+            if (!current->m_next_prev.erased() && current->m_data == elem)
             {
-                last_found = current;
+                return iterator(prev, current);
             }
-            current = current->m_next_prev;
+            next = current;
+            current = prev;
         }
-
-        return last_found ? iterator(last_found) : end();
+        return end();
     }
 
     template <typename T, typename allocator>
     typename xor_list<T, allocator>::iterator xor_list<T, allocator>::find(const_reference elem)
     {
+        Node *prev = nullptr;
         Node *current = m_head;
 
         while (current)
         {
             if (current->m_data == elem)
             {
-                return iterator(current);
+                return iterator(prev, current);
             }
-            current = current->m_next_prev;
-
-            return end();
+            advance(prev, current);
         }
+        return end();
     }
 
     template <typename T, typename allocator>
@@ -1021,122 +2315,236 @@ namespace my_std
     template <typename T, typename allocator>
     void xor_list<T, allocator>::sort()
     {
-        if (!m_head || !m_head->m_next_prev)
-        {
-            return;
-        }
-
-        std::vector<T> elements;
-
-        for (Node *current = m_head; current; current = current->m_next_prev)
+        if constexpr (std::is_integral_v<T>)
         {
-            elements.push_back(current->m_data);
+            sort_by_key([](const T &val)
+                        { return val; });
         }
-
-        std::sort(elements.begin(), elements.end());
-
-        clear();
-
-        for (const auto &value : elements)
+        else
         {
-            push_back(value);
+            compact();
+            sort_chain(m_head, m_tail, m_size, std::less<>());
         }
     }
+
     template <typename T, typename allocator>
-    void xor_list<T, allocator>::reverse()
+    template <typename KeyFn>
+    void xor_list<T, allocator>::sort_by_key(KeyFn key)
     {
-        if (!m_head || !m_head->m_next_prev)
-        {
+        using raw_key = std::remove_cvref_t<std::invoke_result_t<KeyFn &, const T &>>;
+        static_assert(std::is_integral_v<raw_key>, "sort_by_key requires an integral key");
+        using key_type = std::conditional_t<std::is_same_v<raw_key, bool>, unsigned char, raw_key>;
+        using bits_type = std::make_unsigned_t<key_type>;
+        constexpr int passes = sizeof(bits_type);
 
+        compact();
+        if (!m_head || m_head == m_tail)
+        {
             return;
         }
 
-        Node *prev = nullptr;
-        Node *current = m_head;
-        Node *next;
+        auto radix = [&key](const T &val)
+        {
+            bits_type bits = static_cast<bits_type>(static_cast<key_type>(std::invoke(key, val)));
+            if constexpr (std::is_signed_v<key_type>)
+            {
+                bits ^= bits_type(1) << (sizeof(bits_type) * 8 - 1);
+            }
+            return bits;
+        };
 
-        while (current)
+        bits_type first = radix(m_head->m_data);
+        bits_type varying = 0;
+        for (Node *prev = nullptr, *current = m_head; current;)
         {
+            varying |= radix(current->m_data) ^ first;
+            Node *next = XOR(prev, current->m_next_prev);
+            prev = current;
+            current = next;
+        }
 
-            next = XOR(current->m_next_prev, prev);
+        Node *heads[256];
+        Node *tails[256];
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            int shift = pass * 8;
+            if (!((varying >> shift) & 0xFF))
+            {
+                continue;
+            }
 
-            current->m_next_prev = XOR(prev, next);
+            std::fill(std::begin(heads), std::end(heads), nullptr);
+            std::fill(std::begin(tails), std::end(tails), nullptr);
 
-            prev = current;
-            current = next;
+            Node *prev = nullptr;
+            Node *current = m_head;
+            while (current)
+            {
+                Node *next = XOR(prev, current->m_next_prev);
+                std::size_t bucket = (radix(current->m_data) >> shift) & 0xFF;
+                chain::link_back(heads[bucket], tails[bucket], current);
+                prev = current;
+                current = next;
+            }
+
+            m_head = nullptr;
+            m_tail = nullptr;
+            for (int bucket = 0; bucket < 256; ++bucket)
+            {
+                chain::append(m_head, m_tail, heads[bucket], tails[bucket]);
+            }
         }
+    }
 
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::reverse()
+    {
         std::swap(m_head, m_tail);
     }
 
     template <typename T, typename allocator>
     typename xor_list<T, allocator>::iterator xor_list<T, allocator>::insert(iterator pos, size_type size, const_reference val)
     {
-       
-        if (pos == begin())
+        iterator first = pos;
+        for (size_type i = 0; i < size; ++i)
         {
-            for (size_type i = 0; i < size; ++i)
+            iterator it = insert(pos, val);
+            if (i == 0)
             {
-                push_front(val); 
+                first = it;
             }
-            return begin();
+            pos = iterator(it.ptr, pos.ptr);
         }
+        return first;
+    }
 
-        Node *current = pos.m_node;
-        Node *prev = nullptr; 
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::cursor xor_list<T, allocator>::begin_cursor()
+    {
+        return cursor(this, nullptr, m_head);
+    }
 
-        
-        if (current)
-        {
-            prev = XOR(nullptr, current->m_next_prev);
-        }
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::cursor xor_list<T, allocator>::end_cursor()
+    {
+        return cursor(this, m_tail, nullptr);
+    }
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::cursor xor_list<T, allocator>::cursor_at(iterator pos)
+    {
+        return cursor(this, pos.prev, pos.ptr);
+    }
 
-        Node *new_first = nullptr;
-        Node *new_last = nullptr;  
+    // ===================================== cursor ============================================
 
-        for (size_type i = 0; i < size; ++i)
+    template <typename T, typename allocator>
+    xor_list<T, allocator>::cursor::cursor(xor_list *list, Node *prev, Node *current) : m_list(list), m_prev(prev), m_current(current) {}
+
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::reference xor_list<T, allocator>::cursor::operator*() const
+    {
+        if (!m_current)
         {
-            Node *new_node = m_allocator.allocate();
-            m_allocator.construct(new_node, val);
+            throw std::logic_error("Trying to dereference an invalid iterator");
+        }
+        return m_current->m_data;
+    }
 
-            if (!new_first)
-            {
-                new_first = new_node; 
-            }
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::pointer_type xor_list<T, allocator>::cursor::operator->() const
+    {
+        return std::addressof(**this);
+    }
 
-            if (new_last)
-            {
-              
-                new_node->m_next_prev = XOR(new_last, nullptr);
-                new_last->m_next_prev = XOR(new_last->m_next_prev, new_node);
-            }
+    template <typename T, typename allocator>
+    bool xor_list<T, allocator>::cursor::at_begin() const
+    {
+        return m_prev == nullptr;
+    }
 
-            new_last = new_node; 
-        }
+    template <typename T, typename allocator>
+    bool xor_list<T, allocator>::cursor::at_end() const
+    {
+        return m_current == nullptr;
+    }
 
-    
-        if (prev)
+    template <typename T, typename allocator>
+    bool xor_list<T, allocator>::cursor::move_next()
+    {
+        if (!m_current)
         {
-            prev->m_next_prev = XOR(new_last, XOR(prev->m_next_prev, current));
+            return false;
         }
+        m_list->advance(m_prev, m_current);
+        return true;
+    }
 
-        if (current)
+    template <typename T, typename allocator>
+    bool xor_list<T, allocator>::cursor::move_prev()
+    {
+        if (!m_prev)
         {
-            current->m_next_prev = XOR(new_last, XOR(current->m_next_prev, prev));
+            return false;
         }
+        do
+        {
+            Node *before = m_list->XOR(m_prev->m_next_prev, m_current);
+            m_current = m_prev;
+            m_prev = before;
+        } while (m_current->m_next_prev.erased());
+        return true;
+    }
+
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::cursor::insert_before(const_reference val)
+    {
+        Node *node = m_list->m_allocator.allocate();
+        m_list->m_allocator.construct(node, val);
+        m_list->link_between(m_prev, m_current, node);
+        m_prev = node;
+    }
 
-        if (!prev)
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::cursor::insert_after(const_reference val)
+    {
+        if (!m_current)
         {
-            m_head = new_first;
+            throw std::logic_error("Trying to dereference an invalid iterator");
         }
+        Node *node = m_list->m_allocator.allocate();
+        m_list->m_allocator.construct(node, val);
+        m_list->link_between(m_current, m_list->XOR(m_prev, m_current->m_next_prev), node);
+    }
 
-        if (!current)
+    template <typename T, typename allocator>
+    void xor_list<T, allocator>::cursor::erase_current()
+    {
+        if (!m_current)
         {
-            m_tail = new_last;
+            throw std::logic_error("Attempt to erase an invalid iterator");
         }
+        m_list->unlink_node(m_prev, m_current);
+    }
 
-        return iterator(new_first);
+    template <typename T, typename allocator>
+    typename xor_list<T, allocator>::iterator xor_list<T, allocator>::cursor::position() const
+    {
+        return iterator(m_prev, m_current);
     }
+}
 
+namespace std
+{
+    template <typename T, typename allocator>
+    size_t hash<my_std::xor_list<T, allocator>>::operator()(const my_std::xor_list<T, allocator> &list) const
+    {
+        size_t seed = list.size();
+        for (const auto &elem : list)
+        {
+            seed ^= hash<T>()(elem) + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,68 @@
+#ifndef XOR_XOR_LIST_PARALLEL_H
+#define XOR_XOR_LIST_PARALLEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <execution>
+#include <iterator>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "xor_list.h"
+
+namespace my_std
+{
+    // Execution-policy overloads for xor_list. They live apart from
+    // xor_list.h so the core header does not pull in <execution>, whose
+    // parallel backend needs TBB with libstdc++. With par or par_unseq the
+    // work is split over std::thread, at least parallel_grain elements per
+    // thread; seq and unseq run on the calling thread.
+    struct xor_list_parallel
+    {
+        using size_type = std::size_t;
+
+        static constexpr size_type parallel_grain = size_type(1) << 15;
+
+        // Each worker builds its slice into its own sub-list through a copy
+        // of the allocator; the sub-lists are then spliced on in order.
+        template <typename ExecutionPolicy, typename RandomIt, typename allocator = Allocator<std::iter_value_t<RandomIt>>>
+            requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+        static xor_list<std::iter_value_t<RandomIt>, allocator> build(ExecutionPolicy &&policy, RandomIt first, RandomIt last, const allocator &aloc = allocator());
+        template <typename ExecutionPolicy, typename T, typename allocator>
+            requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+        static xor_list<T, allocator> copy(ExecutionPolicy &&policy, const xor_list<T, allocator> &rhv);
+        template <typename ExecutionPolicy, typename T, typename allocator, typename RandomIt>
+            requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+        static void assign(ExecutionPolicy &&policy, xor_list<T, allocator> &list, RandomIt first, RandomIt last);
+        template <typename ExecutionPolicy, typename T, typename allocator>
+            requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+        static void assign(ExecutionPolicy &&policy, xor_list<T, allocator> &list, const xor_list<T, allocator> &rhv);
+
+        // The caller scans the front half from the head while a worker scans
+        // the back half from the tail. find keeps first-match semantics.
+        template <typename ExecutionPolicy, typename T, typename allocator>
+            requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+        static typename xor_list<T, allocator>::iterator find(ExecutionPolicy &&policy, xor_list<T, allocator> &list, const T &elem);
+        template <typename ExecutionPolicy, typename T, typename allocator>
+            requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+        static size_type count(ExecutionPolicy &&policy, const xor_list<T, allocator> &list, const T &elem);
+        template <typename ExecutionPolicy, typename T, typename allocator>
+            requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+        static bool contains(ExecutionPolicy &&policy, const xor_list<T, allocator> &list, const T &elem);
+        template <typename ExecutionPolicy, typename T, typename allocator, typename Pred>
+            requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+        static bool any_of(ExecutionPolicy &&policy, const xor_list<T, allocator> &list, Pred pred);
+
+    private:
+        template <typename ExecutionPolicy>
+        static size_type parallel_parts(size_type count);
+        template <typename T, typename allocator, typename BuildPart>
+        static void build_parts(xor_list<T, allocator> &list, size_type parts, BuildPart build);
+        template <typename T, typename allocator, typename Visit>
+        static void scan_halves(const xor_list<T, allocator> &list, Visit visit);
+    };
+}
+#include "xor_list_parallel.hpp"
+#endif
@@ -0,0 +1,339 @@
+#ifndef XOR_XOR_LIST_PARALLEL_HPP
+#define XOR_XOR_LIST_PARALLEL_HPP
+#include "xor_list_parallel.h"
+
+namespace my_std
+{
+    template <typename ExecutionPolicy, typename RandomIt, typename allocator>
+        requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    xor_list<std::iter_value_t<RandomIt>, allocator> xor_list_parallel::build(ExecutionPolicy &&, RandomIt first, RandomIt last, const allocator &aloc)
+    {
+        using list_type = xor_list<std::iter_value_t<RandomIt>, allocator>;
+
+        list_type result(aloc);
+        size_type count = static_cast<size_type>(last - first);
+        size_type parts = parallel_parts<ExecutionPolicy>(count);
+        build_parts(result, parts, [&](size_type part, list_type &piece)
+                    {
+                        RandomIt it = first + count * part / parts;
+                        RandomIt stop = first + count * (part + 1) / parts;
+                        for (; it != stop; ++it)
+                        {
+                            piece.push_back(*it);
+                        } });
+        return result;
+    }
+
+    template <typename ExecutionPolicy, typename T, typename allocator>
+        requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    xor_list<T, allocator> xor_list_parallel::copy(ExecutionPolicy &&, const xor_list<T, allocator> &rhv)
+    {
+        using list_type = xor_list<T, allocator>;
+        using Node = typename list_type::Node;
+
+        list_type result(rhv.get_allocator());
+        size_type count = rhv.size();
+        size_type parts = parallel_parts<ExecutionPolicy>(count);
+        std::vector<std::pair<Node *, Node *>> starts;
+        starts.reserve(parts);
+
+        Node *prev = nullptr;
+        Node *current = rhv.m_head;
+        size_type index = 0;
+        for (size_type part = 0; part < parts; ++part)
+        {
+            for (size_type stop = count * part / parts; index < stop; ++index)
+            {
+                rhv.advance(prev, current);
+            }
+            starts.emplace_back(prev, current);
+        }
+
+        build_parts(result, parts, [&](size_type part, list_type &piece)
+                    {
+                        auto [prev, current] = starts[part];
+                        size_type length = count * (part + 1) / parts - count * part / parts;
+                        for (size_type i = 0; i < length; ++i)
+                        {
+                            piece.push_back(current->m_data);
+                            rhv.advance(prev, current);
+                        } });
+        return result;
+    }
+
+    template <typename ExecutionPolicy, typename T, typename allocator, typename RandomIt>
+        requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    void xor_list_parallel::assign(ExecutionPolicy &&policy, xor_list<T, allocator> &list, RandomIt first, RandomIt last)
+    {
+        xor_list<T, allocator> built = build(std::forward<ExecutionPolicy>(policy), first, last, list.get_allocator());
+        list.clear();
+        list.splice_back(built);
+    }
+
+    template <typename ExecutionPolicy, typename T, typename allocator>
+        requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    void xor_list_parallel::assign(ExecutionPolicy &&policy, xor_list<T, allocator> &list, const xor_list<T, allocator> &rhv)
+    {
+        if (std::addressof(list) == std::addressof(rhv))
+        {
+            return;
+        }
+        xor_list<T, allocator> built = copy(std::forward<ExecutionPolicy>(policy), rhv);
+        list.clear();
+        list.splice_back(built);
+    }
+
+    template <typename ExecutionPolicy, typename T, typename allocator>
+        requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    typename xor_list<T, allocator>::iterator xor_list_parallel::find(ExecutionPolicy &&, xor_list<T, allocator> &list, const T &elem)
+    {
+        using list_type = xor_list<T, allocator>;
+        using Node = typename list_type::Node;
+
+        if (parallel_parts<ExecutionPolicy>(list.m_size) < 2)
+        {
+            return list.find(elem);
+        }
+
+        std::pair<Node *, Node *> front_hit{nullptr, nullptr};
+        std::pair<Node *, Node *> back_hit{nullptr, nullptr};
+        scan_halves(list, [&](Node *prev, Node *node, bool from_back)
+                    {
+                        if (!(node->m_data == elem))
+                        {
+                            return false;
+                        }
+                        if (from_back)
+                        {
+                            back_hit = {prev, node};
+                            return false;
+                        }
+                        front_hit = {prev, node};
+                        return true; });
+
+        if (front_hit.second)
+        {
+            return typename list_type::iterator(front_hit.first, front_hit.second);
+        }
+        if (back_hit.second)
+        {
+            return typename list_type::iterator(back_hit.first, back_hit.second);
+        }
+        return list.end();
+    }
+
+    template <typename ExecutionPolicy, typename T, typename allocator>
+        requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    xor_list_parallel::size_type xor_list_parallel::count(ExecutionPolicy &&, const xor_list<T, allocator> &list, const T &elem)
+    {
+        using Node = typename xor_list<T, allocator>::Node;
+
+        if (parallel_parts<ExecutionPolicy>(list.m_size) < 2)
+        {
+            return static_cast<size_type>(std::count(list.begin(), list.end(), elem));
+        }
+
+        size_type front_count = 0;
+        size_type back_count = 0;
+        scan_halves(list, [&](Node *, Node *node, bool from_back)
+                    {
+                        if (node->m_data == elem)
+                        {
+                            ++(from_back ? back_count : front_count);
+                        }
+                        return false; });
+        return front_count + back_count;
+    }
+
+    template <typename ExecutionPolicy, typename T, typename allocator>
+        requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    bool xor_list_parallel::contains(ExecutionPolicy &&policy, const xor_list<T, allocator> &list, const T &elem)
+    {
+        return any_of(std::forward<ExecutionPolicy>(policy), list, [&elem](const T &val)
+                      { return val == elem; });
+    }
+
+    template <typename ExecutionPolicy, typename T, typename allocator, typename Pred>
+        requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    bool xor_list_parallel::any_of(ExecutionPolicy &&, const xor_list<T, allocator> &list, Pred pred)
+    {
+        using Node = typename xor_list<T, allocator>::Node;
+
+        if (parallel_parts<ExecutionPolicy>(list.m_size) < 2)
+        {
+            return std::any_of(list.begin(), list.end(), pred);
+        }
+
+        std::atomic<bool> found{false};
+        scan_halves(list, [&](Node *, Node *node, bool)
+                    {
+                        if (!pred(node->m_data))
+                        {
+                            return false;
+                        }
+                        found.store(true, std::memory_order_relaxed);
+                        return true; });
+        return found.load(std::memory_order_relaxed);
+    }
+
+    template <typename ExecutionPolicy>
+    xor_list_parallel::size_type xor_list_parallel::parallel_parts(size_type count)
+    {
+        using policy = std::remove_cvref_t<ExecutionPolicy>;
+        if constexpr (std::is_same_v<policy, std::execution::parallel_policy> ||
+                      std::is_same_v<policy, std::execution::parallel_unsequenced_policy>)
+        {
+            size_type threads = std::max(1u, std::thread::hardware_concurrency());
+            return std::clamp<size_type>(count / parallel_grain, 1, threads);
+        }
+        else
+        {
+            return 1;
+        }
+    }
+
+    template <typename T, typename allocator, typename BuildPart>
+    void xor_list_parallel::build_parts(xor_list<T, allocator> &list, size_type parts, BuildPart build)
+    {
+        if (parts <= 1)
+        {
+            build(0, list);
+            return;
+        }
+
+        std::vector<xor_list<T, allocator>> pieces;
+        pieces.reserve(parts);
+        for (size_type part = 0; part < parts; ++part)
+        {
+            pieces.emplace_back(list.get_allocator());
+        }
+
+        std::vector<std::exception_ptr> errors(parts);
+        auto run = [&](size_type part)
+        {
+            try
+            {
+                build(part, pieces[part]);
+            }
+            catch (...)
+            {
+                errors[part] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(parts - 1);
+        for (size_type part = 1; part < parts; ++part)
+        {
+            try
+            {
+                workers.emplace_back(run, part);
+            }
+            catch (const std::system_error &)
+            {
+                run(part);
+            }
+        }
+        run(0);
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+
+        for (auto &error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+        for (auto &piece : pieces)
+        {
+            list.splice_back(piece);
+        }
+    }
+
+    template <typename T, typename allocator, typename Visit>
+    void xor_list_parallel::scan_halves(const xor_list<T, allocator> &list, Visit visit)
+    {
+        using Node = typename xor_list<T, allocator>::Node;
+
+        size_type half = list.m_size / 2;
+        std::atomic<bool> stop{false};
+        std::exception_ptr error;
+
+        auto back_half = [&]
+        {
+            try
+            {
+                Node *next = nullptr;
+                Node *current = list.m_tail;
+                for (size_type i = list.m_size; i > half && !stop.load(std::memory_order_relaxed); --i)
+                {
+                    Node *prev = list.XOR(current->m_next_prev, next);
+                    if (!current->m_next_prev.erased() && visit(prev, current, true))
+                    {
+                        stop.store(true, std::memory_order_relaxed);
+                        return;
+                    }
+                    next = current;
+                    current = prev;
+                }
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+                stop.store(true, std::memory_order_relaxed);
+            }
+        };
+
+        std::thread worker;
+        try
+        {
+            worker = std::thread(back_half);
+        }
+        catch (const std::system_error &)
+        {
+        }
+
+        try
+        {
+            Node *prev = nullptr;
+            Node *current = list.m_head;
+            for (size_type i = 0; i < half && !stop.load(std::memory_order_relaxed); ++i)
+            {
+                if (!current->m_next_prev.erased() && visit(prev, current, false))
+                {
+                    stop.store(true, std::memory_order_relaxed);
+                    break;
+                }
+                Node *next = list.XOR(prev, current->m_next_prev);
+                prev = current;
+                current = next;
+            }
+        }
+        catch (...)
+        {
+            stop.store(true, std::memory_order_relaxed);
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+            throw;
+        }
+
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+        else
+        {
+            back_half();
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+#endif
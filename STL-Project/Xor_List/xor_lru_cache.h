@@ -0,0 +1,90 @@
+#ifndef XOR_XOR_LRU_CACHE_H
+#define XOR_XOR_LRU_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "xor_list.h"
+
+namespace my_std
+{
+    // Entries live in an xor_list ordered from most to least recently used.
+    // An open-addressing index maps each key to its node and to the node's
+    // neighbour towards the front, which is all an XOR node needs to be
+    // unlinked in O(1). Each node remembers its index slot so neighbours can
+    // be fixed up when it moves.
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+    class xor_lru_cache
+    {
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using size_type = std::size_t;
+        using weigher_type = std::function<size_type(const K &, const V &)>;
+
+        enum class capacity_mode
+        {
+            entries,
+            bytes
+        };
+
+    private:
+        struct Entry
+        {
+            K m_key;
+            V m_value;
+            std::uint32_t m_slot;
+        };
+        using list_type = xor_list<Entry>;
+        using Node = typename list_type::Node;
+
+        struct Slot
+        {
+            Node *m_node;
+            Node *m_prev;
+        };
+
+    public:
+        explicit xor_lru_cache(size_type capacity, capacity_mode mode = capacity_mode::entries, weigher_type weigher = weigher_type());
+        xor_lru_cache(const xor_lru_cache &) = delete;
+        xor_lru_cache &operator=(const xor_lru_cache &) = delete;
+
+    public:
+        V *get(const K &key);
+        const V *peek(const K &key) const;
+        bool contains(const K &key) const;
+        void put(const K &key, const V &value);
+        bool erase(const K &key);
+        void clear();
+
+        size_type size() const;
+        size_type capacity() const;
+        size_type usage() const;
+        capacity_mode mode() const;
+
+    private:
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        size_type home(const K &key) const;
+        size_type find_slot(const K &key) const;
+        void place(Node *node, Node *prev);
+        void remove_slot(size_type index);
+        void rehash(size_type slots);
+        void touch(size_type index);
+        void unlink(size_type index);
+        void evict();
+        size_type charge(const Entry &entry) const;
+
+    private:
+        list_type m_list;
+        std::vector<Slot> m_slots;
+        size_type m_capacity;
+        size_type m_usage = 0;
+        capacity_mode m_mode;
+        weigher_type m_weigher;
+        Hash m_hash;
+        KeyEqual m_equal;
+    };
+}
+#include "xor_lru_cache.hpp"
+#endif
@@ -0,0 +1,276 @@
+#ifndef XOR_XOR_LRU_CACHE_HPP
+#define XOR_XOR_LRU_CACHE_HPP
+#include "xor_lru_cache.h"
+
+namespace my_std
+{
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    xor_lru_cache<K, V, Hash, KeyEqual>::xor_lru_cache(size_type capacity, capacity_mode mode, weigher_type weigher)
+        : m_capacity(capacity), m_mode(mode), m_weigher(std::move(weigher))
+    {
+        size_type slots = 16;
+        while (m_mode == capacity_mode::entries && slots < capacity * 2)
+        {
+            slots *= 2;
+        }
+        rehash(slots);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    V *xor_lru_cache<K, V, Hash, KeyEqual>::get(const K &key)
+    {
+        size_type index = find_slot(key);
+        if (index == npos)
+        {
+            return nullptr;
+        }
+        touch(index);
+        return &m_slots[index].m_node->m_data.m_value;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    const V *xor_lru_cache<K, V, Hash, KeyEqual>::peek(const K &key) const
+    {
+        size_type index = find_slot(key);
+        return index == npos ? nullptr : &m_slots[index].m_node->m_data.m_value;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    bool xor_lru_cache<K, V, Hash, KeyEqual>::contains(const K &key) const
+    {
+        return find_slot(key) != npos;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    void xor_lru_cache<K, V, Hash, KeyEqual>::put(const K &key, const V &value)
+    {
+        size_type index = find_slot(key);
+        if (index != npos)
+        {
+            Entry &entry = m_slots[index].m_node->m_data;
+            m_usage -= charge(entry);
+            entry.m_value = value;
+            m_usage += charge(entry);
+            touch(index);
+            evict();
+            return;
+        }
+
+        if ((m_list.size() + 1) * 2 > m_slots.size())
+        {
+            rehash(m_slots.size() * 2);
+        }
+
+        m_list.push_front(Entry{key, value, 0});
+        Node *node = m_list.m_head;
+        Node *next = m_list.XOR(nullptr, node->m_next_prev);
+        if (next)
+        {
+            m_slots[next->m_data.m_slot].m_prev = node;
+        }
+        place(node, nullptr);
+        m_usage += charge(node->m_data);
+        evict();
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    bool xor_lru_cache<K, V, Hash, KeyEqual>::erase(const K &key)
+    {
+        size_type index = find_slot(key);
+        if (index == npos)
+        {
+            return false;
+        }
+
+        Node *node = m_slots[index].m_node;
+        m_usage -= charge(node->m_data);
+        unlink(index);
+        remove_slot(index);
+        m_list.free_node(node);
+        --m_list.m_size;
+        return true;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    void xor_lru_cache<K, V, Hash, KeyEqual>::clear()
+    {
+        m_list.clear();
+        for (auto &slot : m_slots)
+        {
+            slot = Slot{nullptr, nullptr};
+        }
+        m_usage = 0;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename xor_lru_cache<K, V, Hash, KeyEqual>::size_type xor_lru_cache<K, V, Hash, KeyEqual>::size() const
+    {
+        return m_list.size();
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename xor_lru_cache<K, V, Hash, KeyEqual>::size_type xor_lru_cache<K, V, Hash, KeyEqual>::capacity() const
+    {
+        return m_capacity;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename xor_lru_cache<K, V, Hash, KeyEqual>::size_type xor_lru_cache<K, V, Hash, KeyEqual>::usage() const
+    {
+        return m_usage;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename xor_lru_cache<K, V, Hash, KeyEqual>::capacity_mode xor_lru_cache<K, V, Hash, KeyEqual>::mode() const
+    {
+        return m_mode;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename xor_lru_cache<K, V, Hash, KeyEqual>::size_type xor_lru_cache<K, V, Hash, KeyEqual>::home(const K &key) const
+    {
+        std::uint64_t h = static_cast<std::uint64_t>(m_hash(key)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_type>(h ^ (h >> 32)) & (m_slots.size() - 1);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename xor_lru_cache<K, V, Hash, KeyEqual>::size_type xor_lru_cache<K, V, Hash, KeyEqual>::find_slot(const K &key) const
+    {
+        size_type mask = m_slots.size() - 1;
+        for (size_type i = home(key); m_slots[i].m_node; i = (i + 1) & mask)
+        {
+            if (m_equal(m_slots[i].m_node->m_data.m_key, key))
+            {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    void xor_lru_cache<K, V, Hash, KeyEqual>::place(Node *node, Node *prev)
+    {
+        size_type mask = m_slots.size() - 1;
+        size_type i = home(node->m_data.m_key);
+        while (m_slots[i].m_node)
+        {
+            i = (i + 1) & mask;
+        }
+        m_slots[i] = Slot{node, prev};
+        node->m_data.m_slot = static_cast<std::uint32_t>(i);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    void xor_lru_cache<K, V, Hash, KeyEqual>::remove_slot(size_type index)
+    {
+        size_type mask = m_slots.size() - 1;
+        size_type j = index;
+        while (true)
+        {
+            j = (j + 1) & mask;
+            if (!m_slots[j].m_node)
+            {
+                break;
+            }
+            size_type k = home(m_slots[j].m_node->m_data.m_key);
+            bool movable = index <= j ? (k <= index || k > j) : (k <= index && k > j);
+            if (movable)
+            {
+                m_slots[index] = m_slots[j];
+                m_slots[index].m_node->m_data.m_slot = static_cast<std::uint32_t>(index);
+                index = j;
+            }
+        }
+        m_slots[index] = Slot{nullptr, nullptr};
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    void xor_lru_cache<K, V, Hash, KeyEqual>::rehash(size_type slots)
+    {
+        m_slots.assign(slots, Slot{nullptr, nullptr});
+
+        Node *prev = nullptr;
+        Node *current = m_list.m_head;
+        while (current)
+        {
+            Node *next = m_list.XOR(prev, current->m_next_prev);
+            place(current, prev);
+            prev = current;
+            current = next;
+        }
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    void xor_lru_cache<K, V, Hash, KeyEqual>::unlink(size_type index)
+    {
+        Node *node = m_slots[index].m_node;
+        Node *prev = m_slots[index].m_prev;
+        Node *next = m_list.XOR(prev, node->m_next_prev);
+
+        if (prev)
+        {
+            prev->m_next_prev = m_list.XOR(m_list.XOR(prev->m_next_prev, node), next);
+        }
+        else
+        {
+            m_list.m_head = next;
+        }
+
+        if (next)
+        {
+            next->m_next_prev = m_list.XOR(m_list.XOR(next->m_next_prev, node), prev);
+            m_slots[next->m_data.m_slot].m_prev = prev;
+        }
+        else
+        {
+            m_list.m_tail = prev;
+        }
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    void xor_lru_cache<K, V, Hash, KeyEqual>::touch(size_type index)
+    {
+        if (!m_slots[index].m_prev)
+        {
+            return;
+        }
+
+        unlink(index);
+
+        Node *node = m_slots[index].m_node;
+        Node *head = m_list.m_head;
+        node->m_next_prev = m_list.XOR(nullptr, head);
+        head->m_next_prev = m_list.XOR(head->m_next_prev, node);
+        m_slots[head->m_data.m_slot].m_prev = node;
+        m_slots[index].m_prev = nullptr;
+        m_list.m_head = node;
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    void xor_lru_cache<K, V, Hash, KeyEqual>::evict()
+    {
+        while (m_usage > m_capacity && !m_list.empty())
+        {
+            Node *victim = m_list.m_tail;
+            m_usage -= charge(victim->m_data);
+            remove_slot(victim->m_data.m_slot);
+            m_list.pop_back();
+        }
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    typename xor_lru_cache<K, V, Hash, KeyEqual>::size_type xor_lru_cache<K, V, Hash, KeyEqual>::charge(const Entry &entry) const
+    {
+        if (m_mode == capacity_mode::entries)
+        {
+            return 1;
+        }
+        size_type bytes = sizeof(Node) + 2 * sizeof(Slot);
+        if (m_weigher)
+        {
+            bytes += m_weigher(entry.m_key, entry.m_value);
+        }
+        return bytes;
+    }
+}
+#endif
@@ -0,0 +1,32 @@
+#ifndef XOR_XOR_QUEUE_H
+#define XOR_XOR_QUEUE_H
+
+#include "xor_adaptor.h"
+
+namespace my_std
+{
+    template <typename T, typename allocator = Allocator<T>>
+    class xor_queue : public xor_adaptor<T, allocator, false>
+    {
+        using base = xor_adaptor<T, allocator, false>;
+
+    public:
+        using typename base::list_type;
+        using typename base::size_type;
+        using typename base::reference;
+        using typename base::const_reference;
+
+    public:
+        using base::base;
+
+    public:
+        list_type pop_front_n(size_type n);
+
+        reference front();
+        const_reference front() const;
+        reference back();
+        const_reference back() const;
+    };
+}
+#include "xor_queue.hpp"
+#endif
@@ -0,0 +1,37 @@
+#ifndef XOR_XOR_QUEUE_HPP
+#define XOR_XOR_QUEUE_HPP
+#include "xor_queue.h"
+
+namespace my_std
+{
+    template <typename T, typename allocator>
+    typename xor_queue<T, allocator>::list_type xor_queue<T, allocator>::pop_front_n(size_type n)
+    {
+        return this->take_n(n);
+    }
+
+    template <typename T, typename allocator>
+    typename xor_queue<T, allocator>::reference xor_queue<T, allocator>::front()
+    {
+        return this->next();
+    }
+
+    template <typename T, typename allocator>
+    typename xor_queue<T, allocator>::const_reference xor_queue<T, allocator>::front() const
+    {
+        return this->next();
+    }
+
+    template <typename T, typename allocator>
+    typename xor_queue<T, allocator>::reference xor_queue<T, allocator>::back()
+    {
+        return this->m_list.back();
+    }
+
+    template <typename T, typename allocator>
+    typename xor_queue<T, allocator>::const_reference xor_queue<T, allocator>::back() const
+    {
+        return this->m_list.back();
+    }
+}
+#endif
@@ -0,0 +1,85 @@
+#ifndef XOR_XOR_RECLAIMER_H
+#define XOR_XOR_RECLAIMER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "xor_list.h"
+
+namespace my_std
+{
+    struct reclaimer_stats
+    {
+        std::size_t retired_lists = 0;
+        std::size_t retired_elements = 0;
+        std::size_t reclaimed_lists = 0;
+        std::size_t reclaimed_elements = 0;
+        std::size_t inline_fallbacks = 0;
+        std::size_t pending = 0;
+        std::size_t peak_pending = 0;
+    };
+
+    // Takes over whole xor_lists with an O(1) move and frees their nodes on
+    // a background thread, so tearing a large list down costs the caller a
+    // relink. At most capacity lists wait in the queue; when it is full the
+    // list is cleared on the calling thread instead. The list's allocator
+    // must accept deallocation from another thread.
+    class xor_reclaimer
+    {
+    public:
+        using size_type = std::size_t;
+
+    public:
+        explicit xor_reclaimer(size_type capacity = 1024);
+        xor_reclaimer(const xor_reclaimer &) = delete;
+        xor_reclaimer &operator=(const xor_reclaimer &) = delete;
+        ~xor_reclaimer();
+
+        static xor_reclaimer &global();
+
+    public:
+        template <typename T, typename allocator>
+        bool retire(xor_list<T, allocator> &list);
+        void drain();
+        reclaimer_stats stats() const;
+        size_type capacity() const;
+
+    private:
+        struct Retired
+        {
+            virtual ~Retired() = default;
+            virtual void reclaim() = 0;
+
+            Retired *m_next = nullptr;
+            size_type m_elements = 0;
+        };
+
+        template <typename List>
+        struct RetiredList : Retired
+        {
+            explicit RetiredList(List &list);
+            void reclaim() override;
+
+            List m_list;
+        };
+
+        bool enqueue(std::unique_ptr<Retired> &job);
+        void run();
+
+    private:
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_idle;
+        Retired *m_head = nullptr;
+        Retired *m_tail = nullptr;
+        size_type m_capacity;
+        bool m_busy = false;
+        bool m_stopping = false;
+        reclaimer_stats m_stats;
+        std::thread m_worker;
+    };
+}
+#include "xor_reclaimer.hpp"
+#endif
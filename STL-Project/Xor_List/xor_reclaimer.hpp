@@ -0,0 +1,138 @@
+#ifndef XOR_XOR_RECLAIMER_HPP
+#define XOR_XOR_RECLAIMER_HPP
+#include "xor_reclaimer.h"
+
+namespace my_std
+{
+    inline xor_reclaimer::xor_reclaimer(size_type capacity) : m_capacity(capacity), m_worker(&xor_reclaimer::run, this) {}
+
+    inline xor_reclaimer::~xor_reclaimer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_worker.join();
+    }
+
+    inline xor_reclaimer &xor_reclaimer::global()
+    {
+        static xor_reclaimer reclaimer;
+        return reclaimer;
+    }
+
+    template <typename T, typename allocator>
+    bool xor_reclaimer::retire(xor_list<T, allocator> &list)
+    {
+        if (list.empty())
+        {
+            return true;
+        }
+
+        std::unique_ptr<Retired> job = std::make_unique<RetiredList<xor_list<T, allocator>>>(list);
+        if (enqueue(job))
+        {
+            return true;
+        }
+        job->reclaim();
+        return false;
+    }
+
+    inline bool xor_reclaimer::enqueue(std::unique_ptr<Retired> &job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stats.pending >= m_capacity || m_stopping)
+            {
+                ++m_stats.inline_fallbacks;
+                return false;
+            }
+
+            Retired *node = job.release();
+            if (m_tail)
+            {
+                m_tail->m_next = node;
+            }
+            else
+            {
+                m_head = node;
+            }
+            m_tail = node;
+
+            ++m_stats.retired_lists;
+            m_stats.retired_elements += node->m_elements;
+            m_stats.peak_pending = std::max(m_stats.peak_pending, ++m_stats.pending);
+        }
+        m_wake.notify_one();
+        return true;
+    }
+
+    inline void xor_reclaimer::run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_wake.wait(lock, [this]
+                        { return m_head || m_stopping; });
+            if (!m_head)
+            {
+                return;
+            }
+
+            Retired *node = m_head;
+            m_head = node->m_next;
+            if (!m_head)
+            {
+                m_tail = nullptr;
+            }
+            m_busy = true;
+            lock.unlock();
+
+            size_type elements = node->m_elements;
+            node->reclaim();
+            delete node;
+
+            lock.lock();
+            m_busy = false;
+            --m_stats.pending;
+            ++m_stats.reclaimed_lists;
+            m_stats.reclaimed_elements += elements;
+            if (!m_head)
+            {
+                m_idle.notify_all();
+            }
+        }
+    }
+
+    inline void xor_reclaimer::drain()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this]
+                    { return !m_head && !m_busy; });
+    }
+
+    inline reclaimer_stats xor_reclaimer::stats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    inline xor_reclaimer::size_type xor_reclaimer::capacity() const
+    {
+        return m_capacity;
+    }
+
+    template <typename List>
+    xor_reclaimer::RetiredList<List>::RetiredList(List &list) : m_list(std::move(list))
+    {
+        this->m_elements = m_list.size();
+    }
+
+    template <typename List>
+    void xor_reclaimer::RetiredList<List>::reclaim()
+    {
+        m_list.clear();
+    }
+}
+#endif
@@ -0,0 +1,30 @@
+#ifndef XOR_XOR_STACK_H
+#define XOR_XOR_STACK_H
+
+#include "xor_adaptor.h"
+
+namespace my_std
+{
+    template <typename T, typename allocator = Allocator<T>>
+    class xor_stack : public xor_adaptor<T, allocator, true>
+    {
+        using base = xor_adaptor<T, allocator, true>;
+
+    public:
+        using typename base::list_type;
+        using typename base::size_type;
+        using typename base::reference;
+        using typename base::const_reference;
+
+    public:
+        using base::base;
+
+    public:
+        list_type pop_n(size_type n);
+
+        reference top();
+        const_reference top() const;
+    };
+}
+#include "xor_stack.hpp"
+#endif
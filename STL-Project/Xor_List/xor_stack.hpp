@@ -0,0 +1,25 @@
+#ifndef XOR_XOR_STACK_HPP
+#define XOR_XOR_STACK_HPP
+#include "xor_stack.h"
+
+namespace my_std
+{
+    template <typename T, typename allocator>
+    typename xor_stack<T, allocator>::list_type xor_stack<T, allocator>::pop_n(size_type n)
+    {
+        return this->take_n(n);
+    }
+
+    template <typename T, typename allocator>
+    typename xor_stack<T, allocator>::reference xor_stack<T, allocator>::top()
+    {
+        return this->next();
+    }
+
+    template <typename T, typename allocator>
+    typename xor_stack<T, allocator>::const_reference xor_stack<T, allocator>::top() const
+    {
+        return this->next();
+    }
+}
+#endif